@@ -0,0 +1,157 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <algorithm>
+#include <ext/algorithm>
+#include <ext/radix_sort.h>
+#include <ext/sorting_network.h>
+#include <functional>
+#if __cplusplus > 201703L
+#include <span>
+#endif
+
+namespace bench
+{
+
+namespace
+{
+	// Ascending, then descending: unbalances the partitions of std::sort.
+	void
+	fill_organ_pipe(std::size_t n)
+	{
+		for(std::size_t i = 0U; i < n; ++i)
+		{
+			data[i] = static_cast<std::uint16_t>(i < n / 2U ? i : n - i);
+		}
+	}
+
+	// Small fixed-size sorts and medians: sorting networks against the
+	// generic algorithms.
+	template<std::size_t N>
+	void
+	run_small()
+	{
+		report("sort_n", "network", N,
+		       measure([]{ seed(3U); fill_random(N); },
+		               []{ __gnu_cxx::sort_n<N>(data); }),
+		       N);
+
+		report("sort_n", "std_sort", N,
+		       measure([]{ seed(3U); fill_random(N); },
+		               []{ std::sort(data, data + N); }),
+		       N);
+
+		report("median_n", "network", N,
+		       measure([]{ seed(3U); fill_random(N); },
+		               []{ keep(*__gnu_cxx::median_n<N>(data)); }),
+		       N);
+
+		report("median_n", "nth_element", N,
+		       measure([]{ seed(3U); fill_random(N); },
+		               []{ std::nth_element(data, data + N / 2U, data + N); }),
+		       N);
+	}
+}
+
+void
+run_algorithm()
+{
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		report("sort", "random", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]{ std::sort(data, data + n); }),
+		       n);
+
+		report("sort", "sorted", n,
+		       measure([n]{ std::sort(data, data + n); },
+		               [n]{ std::sort(data, data + n); }),
+		       n);
+
+		report("sort", "reversed", n,
+		       measure([n]{ std::sort(data, data + n, std::greater<std::uint16_t>()); },
+		               [n]{ std::sort(data, data + n); }),
+		       n);
+
+		report("sort", "organ_pipe", n,
+		       measure([n]{ fill_organ_pipe(n); },
+		               [n]{ std::sort(data, data + n); }),
+		       n);
+
+		report("stable_sort", "random", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]{ std::stable_sort(data, data + n); }),
+		       n);
+
+		// Half of keys[] as scratch space: the fastest merge without
+		// touching the heap.
+		report("stable_sort", "buffer", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]{ __gnu_cxx::stable_sort(data, data + n, keys, (n + 1U) / 2U); }),
+		       n);
+
+		report("stable_sort", "no_buffer", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]{ __gnu_cxx::stable_sort(data, data + n, keys, 0); }),
+		       n);
+
+#if __cplusplus > 201703L
+		// keys[] as the scratch buffer, so that no allocation is timed.
+		report("radix_sort", "random", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]{ __gnu_cxx::ranges::radix_sort(data, data + n, std::span(keys, n)); }),
+		       n);
+
+		report("counting_sort", "low_byte", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]
+		               {
+		                   __gnu_cxx::ranges::counting_sort(data, data + n, std::span(keys, n),
+		                                                    [](std::uint16_t x) { return static_cast<std::uint8_t>(x); });
+		               }),
+		       n);
+#endif
+
+		report("nth_element", "random", n,
+		       measure([n]{ seed(1U); fill_random(n); },
+		               [n]{ std::nth_element(data, data + n / 2U, data + n); }),
+		       n);
+
+		// Sorted haystack, random needles.
+		seed(2U);
+		fill_random(n);
+		std::sort(data, data + n);
+		for(std::size_t i = 0U; i < n; ++i)
+		{
+			keys[i] = random();
+		}
+
+		report("lower_bound", "random", n,
+		       measure([]{},
+		               [n]
+		               {
+		                   for(std::size_t i = 0U; i < n; ++i)
+		                   {
+		                       keep(std::lower_bound(data, data + n, keys[i]));
+		                   }
+		               }),
+		       n);
+	}
+
+	run_small<3U>();
+	run_small<5U>();
+	run_small<9U>();
+	run_small<16U>();
+}
+
+}
@@ -0,0 +1,123 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVR__)
+#include <ext/stack_monitor.h>
+#endif
+
+// Number of times each measurement is repeated; the minimum is reported.
+// The simulator is deterministic, so one run suffices there.
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT 1
+#endif
+
+namespace bench
+{
+
+using clock = std::chrono::cycle_clock;
+using cycles = clock::rep;
+
+// Cycles spent by an empty measurement, subtracted from every result.
+extern cycles overhead;
+
+// Most bytes of stack used by f() in the last call of measure(),
+// including interrupts that ran meanwhile. Always zero on a host.
+extern std::size_t stack_peak;
+
+// Largest element count used by the size sweeps.
+constexpr std::size_t max_size = 512;
+
+// Sizes swept by every benchmark, terminated by zero.
+extern const std::size_t sizes[];
+
+// Scratch buffers shared by all benchmarks.
+extern std::uint16_t data[max_size];
+extern std::uint16_t keys[max_size];
+
+// Deterministic 16-bit xorshift generator.
+std::uint16_t random();
+void seed(std::uint16_t s);
+
+// Fill the first n entries of data[] with random values.
+void fill_random(std::size_t n);
+
+// Print one machine-readable result line:
+// BENCH,<group>,<name>,<n>,<total cycles>,<ops>,<cycles per op>,<stack bytes>
+void report(const char* group, const char* name, std::size_t n,
+            cycles total, std::size_t ops);
+
+// Run setup() and then time f(), BENCH_REPEAT times, and return
+// the smallest number of cycles f() took. The stack used by f() is
+// left in stack_peak.
+template<typename Setup, typename F>
+cycles
+measure(Setup setup, F f)
+{
+	cycles best = static_cast<cycles>(-1);
+	stack_peak = 0U;
+
+	for(unsigned i = 0U; i < BENCH_REPEAT; ++i)
+	{
+		setup();
+
+#if defined(__AVR__)
+		using __gnu_cxx::stack_monitor;
+		const std::size_t depth = stack_monitor::depth();
+		stack_monitor::paint();
+#endif
+
+		const auto start = clock::now();
+		f();
+		const auto stop = clock::now();
+
+#if defined(__AVR__)
+		const std::size_t used = stack_monitor::high_water() - depth;
+		if(used > stack_peak)
+		{
+			stack_peak = used;
+		}
+#endif
+
+		const cycles elapsed = (stop - start).count();
+		const cycles c = (elapsed > overhead) ? (elapsed - overhead) : 0U;
+
+		if(c < best)
+		{
+			best = c;
+		}
+	}
+
+	return best;
+}
+
+// Keep the compiler from optimizing away a computed value.
+template<typename T>
+inline void
+keep(const T& value)
+{
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+void run_algorithm();
+void run_containers();
+void run_coroutine();
+void run_functional();
+void run_numeric();
+void run_utility();
+
+}
+
+#endif // BENCH_BENCH_H
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+#
+# This file is part of the modm project.
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+"""Compare two benchmark result files written by `make run`.
+
+Usage: compare.py BASELINE.csv RESULTS.csv [THRESHOLD_PERCENT]
+
+Prints the cycles per operation of every benchmark present in both
+files and exits with status 1 if any of them got slower by more than
+the threshold (default 2%).
+"""
+
+import csv
+import sys
+
+
+def load(path):
+    results = {}
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            if row.get("cycles_per_op"):
+                key = (row["group"], row["name"], int(row["n"]))
+                results[key] = int(row["cycles_per_op"])
+    return results
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    baseline = load(argv[1])
+    current = load(argv[2])
+    threshold = float(argv[3]) if len(argv) > 3 else 2.0
+
+    regressions = 0
+    print(f"{'benchmark':<40} {'before':>10} {'after':>10} {'change':>8}")
+    for key in sorted(baseline.keys() & current.keys()):
+        before, after = baseline[key], current[key]
+        change = 100.0 * (after - before) / before if before else 0.0
+        flag = ""
+        if change > threshold:
+            flag = "  <-- slower"
+            regressions += 1
+        name = "{}/{}/{}".format(*key)
+        print(f"{name:<40} {before:>10} {after:>10} {change:>+7.1f}%{flag}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace bench
+{
+
+namespace
+{
+
+// Node-based containers allocate per element; keep them within the heap.
+constexpr std::size_t max_nodes = 256U;
+
+template<typename Map>
+void
+run_map(const char* group)
+{
+	for(const std::size_t* s = sizes; *s != 0U && *s <= max_nodes; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(3U);
+		fill_random(n);
+
+		{
+			Map m;
+
+			report(group, "insert", n,
+			       measure([&m]{ m.clear(); },
+			               [&m, n]
+			               {
+			                   for(std::size_t i = 0U; i < n; ++i)
+			                   {
+			                       m.emplace(data[i], static_cast<std::uint16_t>(i));
+			                   }
+			               }),
+			       n);
+
+			report(group, "find_hit", n,
+			       measure([]{},
+			               [&m, n]
+			               {
+			                   for(std::size_t i = 0U; i < n; ++i)
+			                   {
+			                       keep(m.find(data[i]));
+			                   }
+			               }),
+			       n);
+
+			report(group, "find_miss", n,
+			       measure([]{},
+			               [&m, n]
+			               {
+			                   for(std::size_t i = 0U; i < n; ++i)
+			                   {
+			                       keep(m.find(static_cast<std::uint16_t>(data[i] ^ 0x5A5AU)));
+			                   }
+			               }),
+			       n);
+
+			report(group, "erase", n,
+			       measure([&m, n]
+			               {
+			                   for(std::size_t i = 0U; i < n; ++i)
+			                   {
+			                       m.emplace(data[i], static_cast<std::uint16_t>(i));
+			                   }
+			               },
+			               [&m, n]
+			               {
+			                   for(std::size_t i = 0U; i < n; ++i)
+			                   {
+			                       m.erase(data[i]);
+			                   }
+			               }),
+			       n);
+		}
+	}
+}
+
+}
+
+void
+run_containers()
+{
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		report("vector", "push_back", n,
+		       measure([]{},
+		               [n]
+		               {
+		                   std::vector<std::uint16_t> v;
+		                   for(std::size_t i = 0U; i < n; ++i)
+		                   {
+		                       v.push_back(static_cast<std::uint16_t>(i));
+		                   }
+		                   keep(v);
+		               }),
+		       n);
+
+		report("vector", "reserve_push_back", n,
+		       measure([]{},
+		               [n]
+		               {
+		                   std::vector<std::uint16_t> v;
+		                   v.reserve(n);
+		                   for(std::size_t i = 0U; i < n; ++i)
+		                   {
+		                       v.push_back(static_cast<std::uint16_t>(i));
+		                   }
+		                   keep(v);
+		               }),
+		       n);
+	}
+
+	run_map<std::map<std::uint16_t, std::uint16_t>>("map");
+	run_map<std::unordered_map<std::uint16_t, std::uint16_t>>("unordered_map");
+}
+
+}
@@ -0,0 +1,135 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <ext/coroutine_executor.h>
+
+namespace bench
+{
+
+#if __cpp_impl_coroutine
+
+namespace
+{
+
+// Frames hold a few pointers besides the locals, so the slot size
+// scales with the pointer width of the target.
+using pool = __gnu_cxx::frame_pool<48U * sizeof(void*), 4U>;
+
+template<typename T = void>
+using task = __gnu_cxx::task<T, pool>;
+
+__gnu_cxx::coroutine_executor executor;
+
+__gnu_cxx::coroutine_event ping;
+__gnu_cxx::coroutine_event pong;
+
+std::uint16_t result;
+
+task<std::uint16_t>
+child(std::uint16_t x)
+{
+	co_return static_cast<std::uint16_t>(x + 1U);
+}
+
+// Every await allocates, starts and destroys a child frame.
+task<>
+await_children(std::size_t n)
+{
+	std::uint16_t sum = 0U;
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		sum = static_cast<std::uint16_t>(sum + co_await child(data[i]));
+	}
+	result = sum;
+}
+
+task<>
+pinger(std::size_t n)
+{
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		ping.set();
+		co_await pong;
+	}
+}
+
+task<>
+ponger(std::size_t n)
+{
+	std::uint16_t count = 0U;
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		co_await ping;
+		++count;
+		pong.set();
+	}
+	result = count;
+}
+
+task<>
+sleeper(std::size_t n)
+{
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		co_await __gnu_cxx::sleep_for(std::chrono::microseconds(1));
+	}
+	result = static_cast<std::uint16_t>(n);
+}
+
+template<typename Spawn>
+void
+run_tasks(const char* name, Spawn spawn)
+{
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(9U);
+		fill_random(n);
+
+		report("coroutine", name, n,
+		       measure([]{},
+		               [n, spawn]
+		               {
+		                   spawn(n);
+		                   executor.run();
+		                   keep(result);
+		               }),
+		       n);
+	}
+}
+
+}
+
+void
+run_coroutine()
+{
+	run_tasks("task_value",
+	          [](std::size_t n) { executor.spawn(await_children(n)); });
+	run_tasks("event",
+	          [](std::size_t n)
+	          {
+	              executor.spawn(ponger(n));
+	              executor.spawn(pinger(n));
+	          });
+	run_tasks("sleep_for",
+	          [](std::size_t n) { executor.spawn(sleeper(n)); });
+}
+
+#else
+
+void
+run_coroutine()
+{ }
+
+#endif
+
+}
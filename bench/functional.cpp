@@ -0,0 +1,137 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <ext/inplace_function.h>
+#include <functional>
+
+namespace bench
+{
+
+namespace
+{
+
+using signature = std::uint16_t(std::uint16_t);
+
+// Captures two pointers and two integers: too large for the inline
+// buffer of std::function on any target, so std::function allocates.
+struct scaler
+{
+	const std::uint16_t* table;
+	const std::uint16_t* limit;
+	std::uint16_t scale;
+	std::uint16_t offset;
+
+	std::uint16_t
+	operator()(std::uint16_t x) const
+	{
+		return static_cast<std::uint16_t>(x * scale + offset + (table < limit));
+	}
+};
+
+scaler
+make_scaler()
+{
+	return scaler{ data, data + max_size, 3U, 7U };
+}
+
+// Calls through a reference, so the target cannot be inlined into the
+// loop, as for a callback stored elsewhere.
+template<typename F>
+void
+call(const F& f, std::size_t n)
+{
+	std::uint16_t sum = 0U;
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		sum = static_cast<std::uint16_t>(sum + f(data[i]));
+	}
+	keep(sum);
+}
+
+template<typename F>
+void
+run_wrapper(const char* name)
+{
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(6U);
+		fill_random(n);
+
+		const F f = make_scaler();
+		report("function_call", name, n,
+		       measure([]{}, [&f, n]{ call(f, n); }),
+		       n);
+	}
+
+	// Construction and destruction, including any allocation.
+	constexpr std::size_t n = 32U;
+	report("function_make", name, n,
+	       measure([]{},
+	               []
+	               {
+	                   for(std::size_t i = 0U; i < n; ++i)
+	                   {
+	                       F f = make_scaler();
+	                       keep(f);
+	                   }
+	               }),
+	       n);
+}
+
+// A function_ref only refers to its target, which must outlive it.
+void
+run_function_ref()
+{
+	const scaler target = make_scaler();
+
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(6U);
+		fill_random(n);
+
+		const std::function_ref<signature> f = target;
+		report("function_call", "function_ref", n,
+		       measure([]{}, [&f, n]{ call(f, n); }),
+		       n);
+	}
+
+	constexpr std::size_t n = 32U;
+	report("function_make", "function_ref", n,
+	       measure([]{},
+	               [&target]
+	               {
+	                   for(std::size_t i = 0U; i < n; ++i)
+	                   {
+	                       std::function_ref<signature> f = target;
+	                       keep(f);
+	                   }
+	               }),
+	       n);
+}
+
+}
+
+void
+run_functional()
+{
+	run_wrapper<std::function<signature>>("std_function");
+	run_wrapper<__gnu_cxx::inplace_function<signature, sizeof(scaler)>>("inplace_function");
+	// Stored in place on a host, but allocated on AVR, where the target is
+	// larger than the default MODM_MOVE_ONLY_FUNCTION_CAPACITY.
+	run_wrapper<std::move_only_function<std::uint16_t(std::uint16_t) const>>("move_only_function");
+	run_function_ref();
+}
+
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <cstdio>
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#endif
+
+namespace bench
+{
+
+cycles overhead;
+
+std::size_t stack_peak;
+
+const std::size_t sizes[] = { 8U, 32U, 128U, max_size, 0U };
+
+std::uint16_t data[max_size];
+std::uint16_t keys[max_size];
+
+namespace
+{
+	std::uint16_t state = 1U;
+}
+
+std::uint16_t
+random()
+{
+	state ^= static_cast<std::uint16_t>(state << 7U);
+	state ^= static_cast<std::uint16_t>(state >> 9U);
+	state ^= static_cast<std::uint16_t>(state << 8U);
+	return state;
+}
+
+void
+seed(std::uint16_t s)
+{
+	state = (s != 0U) ? s : 1U;
+}
+
+void
+fill_random(std::size_t n)
+{
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		data[i] = random();
+	}
+}
+
+void
+report(const char* group, const char* name, std::size_t n, cycles total, std::size_t ops)
+{
+	printf("BENCH,%s,%s,%lu,%lu,%lu,%lu,%lu\n",
+	       group, name,
+	       static_cast<unsigned long>(n),
+	       static_cast<unsigned long>(total),
+	       static_cast<unsigned long>(ops),
+	       static_cast<unsigned long>(ops != 0U ? total / ops : total),
+	       static_cast<unsigned long>(stack_peak));
+}
+
+}
+
+int main()
+{
+#if defined(__AVR__)
+	// The cycle clock extends its hardware timer in the overflow interrupt.
+	sei();
+#endif
+
+	bench::overhead = 0U;
+	bench::overhead = bench::measure([]{}, []{});
+
+	puts("BENCH,group,name,n,cycles,ops,cycles_per_op,stack");
+
+	bench::run_algorithm();
+	bench::run_containers();
+	bench::run_coroutine();
+	bench::run_functional();
+	bench::run_numeric();
+	bench::run_utility();
+
+	puts("BENCH,done");
+
+#if defined(__AVR__)
+	// Sleeping with interrupts disabled ends the simulation.
+	cli();
+	sleep_enable();
+	sleep_cpu();
+#endif
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <bits/charconv.h>
+#include <bits/hash_bytes.h>
+#include <cmath>
+#include <functional>
+
+namespace bench
+{
+
+namespace
+{
+
+// <charconv> is not provided, so measure the primitives std::to_chars
+// is built from.
+void
+to_chars(std::size_t n)
+{
+	char buffer[8];
+
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		const unsigned value = data[i];
+		const unsigned len = std::__detail::__to_chars_len(value);
+		std::__detail::__to_chars_10_impl(buffer, len, value);
+		keep(buffer);
+	}
+}
+
+template<typename F>
+void
+run_cmath(const char* name, F f)
+{
+	constexpr std::size_t n = 64U;
+
+	report("cmath", name, n,
+	       measure([]{},
+	               [f]
+	               {
+	                   for(std::size_t i = 0U; i < n; ++i)
+	                   {
+	                       volatile float x = 0.05F + static_cast<float>(i) * 0.1F;
+	                       keep(f(x));
+	                   }
+	               }),
+	       n);
+}
+
+}
+
+void
+run_numeric()
+{
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(4U);
+		fill_random(n);
+
+		report("to_chars", "uint16", n,
+		       measure([]{}, [n]{ to_chars(n); }),
+		       n);
+
+		report("hash", "uint16", n,
+		       measure([]{},
+		               [n]
+		               {
+		                   for(std::size_t i = 0U; i < n; ++i)
+		                   {
+		                       keep(std::hash<std::uint16_t>()(data[i]));
+		                   }
+		               }),
+		       n);
+
+		// Bytes hashed in one call, reported per byte.
+		report("hash", "bytes", 2U * n,
+		       measure([]{},
+		               [n]{ keep(std::_Hash_bytes(data, 2U * n, 0xC70F6907U)); }),
+		       2U * n);
+	}
+
+	run_cmath("sqrt", [](float x) { return std::sqrt(x); });
+	run_cmath("sin", [](float x) { return std::sin(x); });
+	run_cmath("exp", [](float x) { return std::exp(x); });
+	run_cmath("log", [](float x) { return std::log(x); });
+	run_cmath("atan2", [](float x) { return std::atan2(x, 1.5F); });
+}
+
+}
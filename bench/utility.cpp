@@ -0,0 +1,214 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "bench.h"
+
+#include <expected>
+#include <optional>
+#include <variant>
+
+namespace bench
+{
+
+namespace
+{
+
+// Variants are kept in static arrays; keep them small on the target.
+constexpr std::size_t max_variants = 128U;
+
+template<unsigned N>
+struct alternative
+{
+	std::uint16_t value;
+};
+
+using a0 = alternative<0>;
+using a1 = alternative<1>;
+using a2 = alternative<2>;
+using a3 = alternative<3>;
+
+// Four alternatives are visited with a switch, twelve (more than
+// MODM_VARIANT_VISIT_SWITCH) through a table of function pointers.
+using small_variant = std::variant<a0, a1, a2, a3>;
+using large_variant = std::variant<a0, a1, a2, a3,
+                                   alternative<4>, alternative<5>, alternative<6>, alternative<7>,
+                                   alternative<8>, alternative<9>, alternative<10>, alternative<11>>;
+
+small_variant small_variants[max_variants];
+large_variant large_variants[max_variants];
+
+// Only the first four alternatives are stored in either variant, so both
+// run the same visitor on the same values.
+template<typename Variant>
+void
+fill_variants(Variant* v, std::size_t n)
+{
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		const std::uint16_t x = data[i];
+		switch(x % 4U)
+		{
+			case 0U: v[i] = a0{ x }; break;
+			case 1U: v[i] = a1{ x }; break;
+			case 2U: v[i] = a2{ x }; break;
+			default: v[i] = a3{ x }; break;
+		}
+	}
+}
+
+template<typename Variant>
+void
+run_visit(const char* name, Variant* v)
+{
+	for(const std::size_t* s = sizes; *s != 0U && *s <= max_variants; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(7U);
+		fill_random(n);
+		fill_variants(v, n);
+
+		report("variant_visit", name, n,
+		       measure([]{},
+		               [v, n]
+		               {
+		                   std::uint16_t sum = 0U;
+		                   for(std::size_t i = 0U; i < n; ++i)
+		                   {
+		                       sum = static_cast<std::uint16_t>(sum + std::visit(
+		                           [](const auto& a) { return a.value; }, v[i]));
+		                   }
+		                   keep(sum);
+		               }),
+		       n);
+
+		// Copy assignment visits both the source and, if the alternatives
+		// differ, the destination.
+		report("variant_copy", name, n,
+		       measure([]{},
+		               [v, n]
+		               {
+		                   for(std::size_t i = 1U; i < n; ++i)
+		                   {
+		                       v[i - 1U] = v[i];
+		                   }
+		               }),
+		       n - 1U);
+	}
+}
+
+// Three ways of returning a result or a failure from a function that
+// is not inlined. Every eighth value fails.
+enum class parse_error : std::uint8_t { range = 1 };
+
+__attribute__((noinline)) std::expected<std::uint16_t, parse_error>
+parse_expected(std::uint16_t x)
+{
+	if((x & 7U) == 0U)
+	{
+		return std::unexpected(parse_error::range);
+	}
+	return static_cast<std::uint16_t>(x >> 3U);
+}
+
+__attribute__((noinline)) std::optional<std::uint16_t>
+parse_optional(std::uint16_t x)
+{
+	if((x & 7U) == 0U)
+	{
+		return std::nullopt;
+	}
+	return static_cast<std::uint16_t>(x >> 3U);
+}
+
+__attribute__((noinline)) bool
+parse_out_param(std::uint16_t x, std::uint16_t& out)
+{
+	if((x & 7U) == 0U)
+	{
+		return false;
+	}
+	out = static_cast<std::uint16_t>(x >> 3U);
+	return true;
+}
+
+// Both wrappers are returned in registers: 3 bytes each on AVR.
+static_assert(sizeof(std::expected<std::uint16_t, parse_error>)
+              == sizeof(std::optional<std::uint16_t>));
+
+template<typename Parse>
+void
+run_return(const char* name, Parse parse)
+{
+	for(const std::size_t* s = sizes; *s != 0U; ++s)
+	{
+		const std::size_t n = *s;
+
+		seed(8U);
+		fill_random(n);
+
+		report("error_return", name, n,
+		       measure([]{},
+		               [n, parse]
+		               {
+		                   std::uint16_t sum = 0U;
+		                   std::uint16_t failed = 0U;
+		                   for(std::size_t i = 0U; i < n; ++i)
+		                   {
+		                       std::uint16_t value;
+		                       if(parse(data[i], value))
+		                       {
+		                           sum = static_cast<std::uint16_t>(sum + value);
+		                       }
+		                       else
+		                       {
+		                           ++failed;
+		                       }
+		                   }
+		                   keep(sum);
+		                   keep(failed);
+		               }),
+		       n);
+	}
+}
+
+}
+
+void
+run_utility()
+{
+	run_visit("switch", small_variants);
+	run_visit("table", large_variants);
+
+	run_return("expected",
+	           [](std::uint16_t x, std::uint16_t& value)
+	           {
+	               const auto r = parse_expected(x);
+	               if(r)
+	               {
+	                   value = *r;
+	               }
+	               return r.has_value();
+	           });
+	run_return("optional",
+	           [](std::uint16_t x, std::uint16_t& value)
+	           {
+	               const auto r = parse_optional(x);
+	               if(r)
+	               {
+	                   value = *r;
+	               }
+	               return r.has_value();
+	           });
+	run_return("out_param",
+	           [](std::uint16_t x, std::uint16_t& value)
+	           { return parse_out_param(x, value); });
+}
+
+}
@@ -0,0 +1,21 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <bitset>
+
+int main()
+{
+	std::bitset<64> b(footprint::source());
+
+	b <<= 3U;
+
+	footprint::sink(b.count());
+}
@@ -0,0 +1,19 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <chrono>
+
+int main()
+{
+	const std::chrono::microseconds us(footprint::source());
+
+	footprint::sink(std::chrono::duration_cast<std::chrono::milliseconds>(us).count());
+}
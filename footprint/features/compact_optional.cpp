@@ -0,0 +1,24 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <ext/compact_optional.h>
+
+int main()
+{
+	__gnu_cxx::compact_optional<std::uint16_t, __gnu_cxx::niche_value<0xffffU>> o;
+
+	if(footprint::source() != 0U)
+	{
+		o = footprint::source();
+	}
+
+	footprint::sink(o.value_or(0U));
+}
@@ -0,0 +1,23 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <deque>
+
+int main()
+{
+	std::deque<std::uint16_t> d;
+
+	d.push_back(footprint::source());
+	d.push_front(footprint::source());
+	d.pop_back();
+
+	footprint::sink(d.size() + d.front());
+}
@@ -0,0 +1,18 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+// Baseline: the start-up code and the footprint helpers only.
+// Its sizes are subtracted from every other feature.
+
+#include "footprint.h"
+
+int main()
+{
+	footprint::sink(footprint::source());
+}
@@ -0,0 +1,26 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <expected>
+
+enum class error : std::uint8_t { timeout = 1 };
+
+int main()
+{
+	std::expected<std::uint16_t, error> e = std::unexpected(error::timeout);
+
+	if(footprint::source() != 0U)
+	{
+		e = footprint::source();
+	}
+
+	footprint::sink(e.transform([](std::uint16_t x) { return x + 1U; }).value_or(0U));
+}
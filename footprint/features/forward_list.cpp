@@ -0,0 +1,24 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <forward_list>
+
+int main()
+{
+	std::forward_list<std::uint16_t> l;
+
+	l.push_front(footprint::source());
+	l.push_front(footprint::source());
+	l.sort();
+	l.pop_front();
+
+	footprint::sink(l.front());
+}
@@ -0,0 +1,43 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <ext/ilist.h>
+
+namespace
+{
+
+struct node
+{
+	std::uint16_t value;
+	__gnu_cxx::ilist_hook hook;
+
+	bool
+	operator<(const node& other) const
+	{ return value < other.value; }
+};
+
+node pool[2];
+
+}
+
+int main()
+{
+	__gnu_cxx::ilist<node, &node::hook> l;
+
+	pool[0].value = footprint::source();
+	pool[1].value = footprint::source();
+	l.push_back(pool[0]);
+	l.push_front(pool[1]);
+	l.sort();
+	l.erase(l.begin());
+
+	footprint::sink(l.size() + l.front().value);
+}
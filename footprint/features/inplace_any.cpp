@@ -0,0 +1,20 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <ext/inplace_any.h>
+
+int main()
+{
+	__gnu_cxx::inplace_any<4> a = footprint::source();
+	__gnu_cxx::inplace_any<4> b = a;
+
+	footprint::sink(__gnu_cxx::any_cast<std::uint16_t>(b));
+}
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <ext/iset.h>
+
+namespace
+{
+
+struct node
+{
+	std::uint16_t key;
+	__gnu_cxx::iset_hook hook;
+};
+
+node pool[2];
+
+}
+
+int main()
+{
+	__gnu_cxx::imap<std::uint16_t, node, &node::hook, &node::key> m;
+
+	pool[0].key = footprint::source();
+	pool[1].key = footprint::source();
+	m.insert(pool[0]);
+	m.insert(pool[1]);
+	footprint::sink(m.count(footprint::source()));
+	m.erase(footprint::source());
+
+	footprint::sink(m.size());
+}
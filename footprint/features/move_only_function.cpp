@@ -0,0 +1,22 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <functional>
+
+int main()
+{
+	const std::uint16_t offset = footprint::source();
+
+	std::move_only_function<std::uint16_t(std::uint16_t)> f = [offset](std::uint16_t x) { return x + offset; };
+	std::move_only_function<std::uint16_t(std::uint16_t)> g = std::move(f);
+
+	footprint::sink(g(footprint::source()));
+}
@@ -0,0 +1,20 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <random>
+
+int main()
+{
+	std::minstd_rand engine(footprint::source());
+	std::uniform_int_distribution<std::uint16_t> dist(0U, 1000U);
+
+	footprint::sink(dist(engine));
+}
@@ -0,0 +1,22 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <memory>
+
+int main()
+{
+	std::shared_ptr<std::uint16_t> a = std::make_shared<std::uint16_t>(footprint::source());
+	std::weak_ptr<std::uint16_t> w = a;
+	std::shared_ptr<std::uint16_t> b = w.lock();
+	a.reset();
+
+	footprint::sink(*b);
+}
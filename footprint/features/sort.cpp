@@ -0,0 +1,26 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <algorithm>
+
+int main()
+{
+	std::uint16_t a[16];
+
+	for(auto& x : a)
+	{
+		x = footprint::source();
+	}
+
+	std::sort(a, a + 16);
+
+	footprint::sink(a[0]);
+}
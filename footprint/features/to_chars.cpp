@@ -0,0 +1,24 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+// <charconv> is not provided; measure the primitives std::to_chars is built from.
+#include <bits/charconv.h>
+
+int main()
+{
+	char buffer[8];
+
+	const unsigned value = footprint::source();
+	const unsigned len = std::__detail::__to_chars_len(value);
+	std::__detail::__to_chars_10_impl(buffer, len, value);
+
+	footprint::sink(buffer[0]);
+}
@@ -0,0 +1,24 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <unordered_map>
+
+int main()
+{
+	std::unordered_map<std::uint16_t, std::uint16_t> m;
+
+	m.emplace(footprint::source(), footprint::source());
+	const auto it = m.find(footprint::source());
+	footprint::sink(it != m.end() ? it->second : 0U);
+	m.erase(footprint::source());
+
+	footprint::sink(m.size());
+}
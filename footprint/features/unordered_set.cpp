@@ -0,0 +1,23 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <unordered_set>
+
+int main()
+{
+	std::unordered_set<std::uint16_t> s;
+
+	s.insert(footprint::source());
+	footprint::sink(s.count(footprint::source()));
+	s.erase(footprint::source());
+
+	footprint::sink(s.size());
+}
@@ -0,0 +1,26 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <variant>
+
+int main()
+{
+	std::variant<std::uint8_t, std::uint16_t, std::uint32_t> v;
+
+	switch(footprint::source())
+	{
+		case 0U: v = std::uint8_t(1U);  break;
+		case 1U: v = std::uint16_t(2U); break;
+		default: v = std::uint32_t(3U); break;
+	}
+
+	footprint::sink(std::visit([](auto x) { return static_cast<std::uint16_t>(x); }, v));
+}
@@ -0,0 +1,36 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "footprint.h"
+
+#include <variant>
+
+template<unsigned N>
+struct alternative
+{
+	std::uint16_t value;
+};
+
+int main()
+{
+	// Twelve alternatives, one more than MODM_VARIANT_VISIT_SWITCH allows,
+	// so every visit goes through a table of function pointers.
+	std::variant<alternative<0>, alternative<1>, alternative<2>, alternative<3>,
+	             alternative<4>, alternative<5>, alternative<6>, alternative<7>,
+	             alternative<8>, alternative<9>, alternative<10>, alternative<11>> v;
+
+	switch(footprint::source())
+	{
+		case 0U:  v = alternative<0>{ 1U };   break;
+		case 1U:  v = alternative<5>{ 2U };   break;
+		default:  v = alternative<11>{ 3U };  break;
+	}
+
+	footprint::sink(std::visit([](auto x) { return x.value; }, v));
+}
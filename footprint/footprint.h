@@ -0,0 +1,40 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef FOOTPRINT_FOOTPRINT_H
+#define FOOTPRINT_FOOTPRINT_H
+
+#include <cstdint>
+
+// Every feature is one translation unit with its own main(). Inputs are
+// read from, and results written to, volatile objects so that the code
+// under measurement can neither be constant-folded nor discarded.
+
+namespace footprint
+{
+
+inline volatile std::uint16_t input = 1U;
+inline volatile std::uint16_t output;
+
+template<typename T>
+inline void
+sink(const T& value)
+{
+	output = static_cast<std::uint16_t>(value);
+}
+
+inline std::uint16_t
+source()
+{
+	return input;
+}
+
+}
+
+#endif // FOOTPRINT_FOOTPRINT_H
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# This file is part of the modm project.
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+"""Report the flash and RAM footprint of each feature program.
+
+For every feature, the sizes of .text, .data and .bss of its ELF are
+measured relative to the baseline program, and .progmem is the sum of
+the .progmem* input sections of the feature's own object file (the
+linker merges them into .text, so they cannot be told apart in the
+ELF).  The result is written as CSV.  If budget files are given, the
+script fails when any size exceeds its budget.  A feature is checked
+against the first budget file that has a row for it, so that a budget
+measured on a reference revision also limits the features that have no
+committed row.  With --require-budget, a feature without a row in the
+first budget file fails as well.
+"""
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+
+FIELDS = ("text", "data", "bss", "progmem")
+
+
+def sections(path, size_tool):
+    """Return {section name: size} as reported by `avr-size -A`."""
+    output = subprocess.run([size_tool, "-A", path], check=True,
+                            capture_output=True, text=True).stdout
+    result = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            result[parts[0]] = result.get(parts[0], 0) + int(parts[1])
+    return result
+
+
+def measure(build_dir, feature, size_tool):
+    elf = sections(os.path.join(build_dir, feature + ".elf"), size_tool)
+    obj = sections(os.path.join(build_dir, feature + ".cpp.o"), size_tool)
+    return {
+        "text": elf.get(".text", 0),
+        "data": elf.get(".data", 0),
+        "bss": elf.get(".bss", 0) + elf.get(".noinit", 0),
+        "progmem": sum(size for name, size in obj.items()
+                       if name.startswith(".progmem")),
+    }
+
+
+def load_budget(path):
+    budget = {}
+    with open(path, newline="") as f:
+        for row in csv.DictReader(line for line in f if not line.startswith("#")):
+            budget[row["feature"]] = {k: int(row[k]) for k in FIELDS if row.get(k)}
+    return budget
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--build-dir", default="build")
+    parser.add_argument("--baseline", default="empty")
+    parser.add_argument("--budget", action="append", default=[])
+    parser.add_argument("--require-budget", action="store_true",
+                        help="fail for features without a row in the first budget")
+    parser.add_argument("--output")
+    parser.add_argument("--size-tool", default="avr-size")
+    parser.add_argument("features", nargs="+")
+    args = parser.parse_args()
+
+    base = measure(args.build_dir, args.baseline, args.size_tool)
+    rows = []
+    for feature in sorted(args.features):
+        if feature == args.baseline:
+            continue
+        sizes = measure(args.build_dir, feature, args.size_tool)
+        for key in ("text", "data", "bss"):
+            sizes[key] -= base[key]
+        rows.append((feature, sizes))
+
+    if args.output:
+        # Keep the comment block at the top of an existing file (the budget).
+        header = []
+        if os.path.exists(args.output):
+            with open(args.output) as f:
+                header = [line for line in f if line.startswith("#")]
+        with open(args.output, "w", newline="") as f:
+            f.writelines(header)
+            writer = csv.writer(f)
+            writer.writerow(("feature",) + FIELDS)
+            for feature, sizes in rows:
+                writer.writerow([feature] + [sizes[k] for k in FIELDS])
+
+    budget = {}
+    committed = set()
+    for i, path in enumerate(args.budget):
+        for feature, limits in load_budget(path).items():
+            budget.setdefault(feature, limits)
+            if i == 0:
+                committed.add(feature)
+    failures = 0
+    print(f"{'feature':<24}" + "".join(f"{k:>10}" for k in FIELDS))
+    for feature, sizes in rows:
+        over = [k for k, limit in budget.get(feature, {}).items() if sizes[k] > limit]
+        failures += len(over)
+        note = "  over budget: " + ", ".join(
+            f"{k} {sizes[k]} > {budget[feature][k]}" for k in over) if over else ""
+        if args.require_budget and feature not in committed:
+            failures += 1
+            note += "  no budget row"
+        print(f"{feature:<24}" + "".join(f"{sizes[k]:>10}" for k in FIELDS) + note)
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
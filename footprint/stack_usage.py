@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+#
+# This file is part of the modm project.
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+"""Report the stack frame size of every library function instantiation.
+
+Reads the .su files written by `-fstack-usage` next to the objects in
+the build directory and prints, for every function defined in the
+library's headers or sources, the largest frame any translation unit
+instantiated it with.  Frames marked `dynamic` depend on alloca() or
+variable length arrays, and are only an upper bound if also marked
+`bounded`.
+
+A frame size is per call: recursive algorithms such as std::sort or the
+erase of a std::map need it once per level of recursion.  Measure their
+worst case at run time with <ext/stack_monitor.h>.
+"""
+
+import argparse
+import csv
+import glob
+import os
+import sys
+
+
+def parse(path):
+    """Yield (location, function, bytes, qualifiers) from one .su file."""
+    with open(path, errors="replace") as f:
+        for line in f:
+            parts = line.rstrip("\n").split("\t")
+            if len(parts) != 3:
+                continue
+            where, size, qualifiers = parts
+            # file:line:column:function, where the function itself may
+            # contain colons.
+            fields = where.split(":", 3)
+            if len(fields) != 4:
+                continue
+            location = ":".join(fields[:2])
+            yield location, fields[3], int(size), qualifiers
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--build-dir", default="build")
+    parser.add_argument("--library", default="..",
+                        help="root of the library; only functions in its "
+                             "include/ and src/ directories are reported")
+    parser.add_argument("--output")
+    parser.add_argument("--top", type=int, default=0,
+                        help="print only the largest N frames")
+    args = parser.parse_args()
+
+    roots = [os.path.realpath(os.path.join(args.library, d)) + os.sep
+             for d in ("include", "src")]
+
+    frames = {}
+    for path in glob.glob(os.path.join(args.build_dir, "*.su")):
+        for location, function, size, qualifiers in parse(path):
+            file = os.path.realpath(location.split(":")[0])
+            if not any(file.startswith(root) for root in roots):
+                continue
+            location = os.path.relpath(file, os.path.realpath(args.library)) \
+                + ":" + location.split(":")[1]
+            # Some compilers shorten the names of operators and
+            # constructors, so the location is part of the key.
+            key = (location, function)
+            if key not in frames or size > frames[key][0]:
+                frames[key] = (size, qualifiers)
+
+    rows = sorted(((size, qualifiers, location, function)
+                   for (location, function), (size, qualifiers) in frames.items()),
+                  key=lambda row: (-row[0], row[2], row[3]))
+    if args.top:
+        rows = rows[:args.top]
+
+    if args.output:
+        with open(args.output, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(("bytes", "qualifiers", "location", "function"))
+            writer.writerows(rows)
+
+    for size, qualifiers, location, function in rows:
+        print(f"{size:>6} {qualifiers:<16} {location:<40} {function}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
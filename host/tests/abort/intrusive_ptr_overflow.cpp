@@ -0,0 +1,35 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+// One more pointer than the 8-bit count of an intrusive_ref_counter can
+// hold aborts.
+#define MODM_SHARED_PTR_COUNT_WIDTH 8
+
+#include "../test.h"
+
+#include <ext/intrusive_ptr.h>
+
+struct counted : __gnu_cxx::intrusive_ref_counter<counted>
+{ };
+
+int
+main()
+{
+	static __gnu_cxx::intrusive_ptr<counted> pointers[256];
+
+	pointers[0].reset(new counted);
+	for(int i = 1; i < 255; ++i)
+	{
+		pointers[i] = pointers[0];
+	}
+	TEST_ASSERT(pointers[0]->use_count() == 255U);
+
+	pointers[255] = pointers[0];
+	return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+// One more owner than an 8-bit use count can hold aborts.
+#define MODM_SHARED_PTR_COUNT_WIDTH 8
+
+#include "../test.h"
+
+#include <memory>
+
+int
+main()
+{
+	static std::shared_ptr<int> owners[256];
+
+	owners[0] = std::make_shared<int>(1);
+	for(int i = 1; i < 255; ++i)
+	{
+		owners[i] = owners[0];
+	}
+	TEST_ASSERT(owners[0].use_count() == 255);
+
+	owners[255] = owners[0];
+	return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+// One more weak_ptr than an 8-bit weak count can hold aborts.
+#define MODM_SHARED_PTR_COUNT_WIDTH 8
+
+#include "../test.h"
+
+#include <memory>
+
+int
+main()
+{
+	static std::weak_ptr<int> observers[256];
+
+	const auto owner = std::make_shared<int>(1);
+	// The owners together hold one weak reference.
+	for(int i = 0; i < 254; ++i)
+	{
+		observers[i] = owner;
+	}
+	TEST_ASSERT(!observers[253].expired());
+
+	observers[254] = owner;
+	return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <algorithm>
+#include <array>
+#include <ext/algorithm>
+#include <ext/sorting_network.h>
+#include <functional>
+#include <numeric>
+
+#if __cplusplus > 201703L
+#include <ext/radix_sort.h>
+#endif
+
+namespace
+{
+
+constexpr std::size_t max_size = 600U;
+
+// Records sorted by key; the index tells whether equal keys kept their
+// order and whether every record is still there.
+struct record
+{
+	std::uint16_t key;
+	std::uint16_t index;
+};
+
+bool
+by_key(const record& a, const record& b)
+{ return a.key < b.key; }
+
+bool
+stable(const record* first, const record* last)
+{
+	bool seen[max_size] = {};
+	for(const record* p = first; p != last; ++p)
+	{
+		if(p->index >= last - first || seen[p->index])
+		{
+			return false;
+		}
+		seen[p->index] = true;
+		if(p != first && (p->key < p[-1].key
+		                  || (p->key == p[-1].key && p->index < p[-1].index)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Inputs that hit the different paths of introsort: random, few distinct
+// values, sorted, reversed and organ pipe.
+void
+fill(std::uint16_t* data, std::size_t n, unsigned shape)
+{
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		switch(shape)
+		{
+		case 0U: data[i] = test::random(); break;
+		case 1U: data[i] = test::random() % 4U; break;
+		case 2U: data[i] = static_cast<std::uint16_t>(i); break;
+		case 3U: data[i] = static_cast<std::uint16_t>(n - i); break;
+		default: data[i] = static_cast<std::uint16_t>(i < n / 2U ? i : n - i); break;
+		}
+	}
+}
+
+void
+fill(record* data, std::size_t n, unsigned shape)
+{
+	std::uint16_t keys[max_size];
+	fill(keys, n, shape);
+	for(std::size_t i = 0U; i < n; ++i)
+	{
+		data[i] = { static_cast<std::uint16_t>(keys[i] % 32U),
+		            static_cast<std::uint16_t>(i) };
+	}
+}
+
+constexpr std::size_t sizes[] = { 0U, 1U, 2U, 3U, 15U, 16U, 17U, 100U, 257U, max_size };
+
+void
+test_sort()
+{
+	std::uint16_t input[max_size];
+	std::uint16_t sorted[max_size];
+	std::uint16_t data[max_size];
+
+	for(std::size_t n : sizes)
+	{
+		for(unsigned shape = 0U; shape < 5U; ++shape)
+		{
+			fill(input, n, shape);
+			std::copy(input, input + n, sorted);
+			std::sort(sorted, sorted + n);
+			TEST_ASSERT(std::is_sorted(sorted, sorted + n));
+
+			std::copy(input, input + n, data);
+			std::sort(data, data + n, std::greater<std::uint16_t>());
+			TEST_ASSERT(std::equal(data, data + n, std::reverse_iterator<std::uint16_t*>(sorted + n)));
+
+			if(n > 2U)
+			{
+				std::copy(input, input + n, data);
+				std::nth_element(data, data + n / 2U, data + n);
+				TEST_ASSERT(data[n / 2U] == sorted[n / 2U]);
+				const std::uint16_t median = data[n / 2U];
+				TEST_ASSERT(std::all_of(data, data + n / 2U,
+				                        [median](std::uint16_t v) { return v <= median; }));
+
+				std::copy(input, input + n, data);
+				std::partial_sort(data, data + 3, data + n);
+				TEST_ASSERT(std::equal(data, data + 3, sorted));
+			}
+		}
+	}
+}
+
+void
+test_stable_sort()
+{
+	record data[max_size];
+	record buffer[max_size];
+
+	for(std::size_t n : sizes)
+	{
+		for(unsigned shape = 0U; shape < 5U; ++shape)
+		{
+			fill(data, n, shape);
+			std::stable_sort(data, data + n, by_key);
+			TEST_ASSERT(stable(data, data + n));
+
+			// Without buffer, with part of the buffer it wants and with all of it.
+			const std::ptrdiff_t buffer_sizes[] = { 0, 1, static_cast<std::ptrdiff_t>(n / 8U),
+			                                        static_cast<std::ptrdiff_t>((n + 1U) / 2U) };
+			for(std::ptrdiff_t b : buffer_sizes)
+			{
+				fill(data, n, shape);
+				__gnu_cxx::stable_sort(data, data + n, buffer, b, by_key);
+				TEST_ASSERT(stable(data, data + n));
+
+				// Two sorted halves, merged again.
+				fill(data, n, shape);
+				std::stable_sort(data, data + n / 3U, by_key);
+				std::stable_sort(data + n / 3U, data + n, by_key);
+				__gnu_cxx::inplace_merge(data, data + n / 3U, data + n, buffer, b, by_key);
+				TEST_ASSERT(stable(data, data + n));
+			}
+
+			fill(data, n, shape);
+			std::stable_sort(data, data + n / 2U, by_key);
+			std::stable_sort(data + n / 2U, data + n, by_key);
+			std::inplace_merge(data, data + n / 2U, data + n, by_key);
+			TEST_ASSERT(stable(data, data + n));
+		}
+	}
+}
+
+// Check sort_n and median_n against std::sort for every size they have
+// a network for, and the sizes around the fallback.
+template<std::size_t N>
+void
+test_network()
+{
+	for(unsigned round = 0U; round < 200U; ++round)
+	{
+		std::array<std::uint16_t, N> a;
+		for(auto& v : a)
+		{
+			v = test::random() % (round % 2U ? 4U : 1000U);
+		}
+		std::array<std::uint16_t, N> sorted = a;
+		std::sort(sorted.begin(), sorted.end());
+
+		std::array<std::uint16_t, N> b = a;
+		__gnu_cxx::sort_n(b);
+		TEST_ASSERT(b == sorted);
+
+		b = a;
+		__gnu_cxx::sort_n(b, std::greater<std::uint16_t>());
+		TEST_ASSERT(std::equal(b.rbegin(), b.rend(), sorted.begin()));
+
+		b = a;
+		TEST_ASSERT(*__gnu_cxx::median_n(b) == sorted[N / 2U]);
+	}
+}
+
+template<std::size_t... N>
+void
+test_networks(std::index_sequence<N...>)
+{
+	(void) std::initializer_list<int>{ (test_network<N + 1U>(), 0)... };
+}
+
+#if __cplusplus > 201703L
+void
+test_radix_sort()
+{
+	record data[max_size];
+	record buffer[max_size];
+	std::int16_t values[max_size];
+
+	for(std::size_t n : sizes)
+	{
+		fill(data, n, 0U);
+		__gnu_cxx::ranges::radix_sort(data, data + n, &record::key);
+		TEST_ASSERT(stable(data, data + n));
+
+		fill(data, n, 1U);
+		__gnu_cxx::ranges::radix_sort(std::span(data, n), std::span(buffer, n), &record::key);
+		TEST_ASSERT(stable(data, data + n));
+
+		fill(data, n, 3U);
+		__gnu_cxx::ranges::counting_sort(data, data + n,
+		                                 [](const record& r) { return static_cast<std::uint8_t>(r.key); });
+		TEST_ASSERT(stable(data, data + n));
+
+		for(std::size_t i = 0U; i < n; ++i)
+		{
+			values[i] = static_cast<std::int16_t>(test::random());
+		}
+		__gnu_cxx::ranges::radix_sort(values, values + n);
+		TEST_ASSERT(std::is_sorted(values, values + n));
+
+		std::uint8_t bytes[max_size];
+		for(std::size_t i = 0U; i < n; ++i)
+		{
+			bytes[i] = static_cast<std::uint8_t>(test::random());
+		}
+		__gnu_cxx::ranges::counting_sort(bytes, bytes + n);
+		TEST_ASSERT(std::is_sorted(bytes, bytes + n));
+	}
+}
+#endif
+
+void
+test_numeric()
+{
+	std::uint16_t data[100];
+	std::iota(data, data + 100, std::uint16_t(1U));
+	TEST_ASSERT(std::accumulate(data, data + 100, 0UL) == 5050UL);
+	TEST_ASSERT(std::inner_product(data, data + 3, data, 0UL) == 14UL);
+
+	std::partial_sum(data, data + 100, data);
+	TEST_ASSERT(data[99] == 5050U);
+	TEST_ASSERT(std::lower_bound(data, data + 100, 15U) - data == 4);
+	TEST_ASSERT(std::upper_bound(data, data + 100, 15U) - data == 5);
+	TEST_ASSERT(std::binary_search(data, data + 100, 5050U));
+	TEST_ASSERT(std::gcd(84, 36) == 12 && std::lcm(4, 6) == 12);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_sort();
+	test_stable_sort();
+	test_networks(std::make_index_sequence<17U>());
+#if __cplusplus > 201703L
+	test_radix_sort();
+#endif
+	test_numeric();
+	return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <any>
+#include <ext/inplace_any.h>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+
+// Counts its live instances, to find leaked or doubly destroyed values.
+template<std::size_t Size>
+struct tracked
+{
+	static int live;
+
+	unsigned char bytes[Size] = {};
+
+	explicit tracked(unsigned char b = 0U) { bytes[0] = b; ++live; }
+	tracked(const tracked& other) { bytes[0] = other.bytes[0]; ++live; }
+	tracked(tracked&& other) noexcept { bytes[0] = other.bytes[0]; ++live; }
+	~tracked() { --live; }
+	tracked& operator=(const tracked&) = default;
+};
+
+template<std::size_t Size>
+int tracked<Size>::live = 0;
+
+using small = tracked<1U>;
+using big = tracked<32U>;
+
+void
+test_any()
+{
+	{
+		std::any a;
+		TEST_ASSERT(!a.has_value());
+
+		a = small(3U);
+		TEST_ASSERT(a.has_value() && std::any_cast<small>(&a)->bytes[0] == 3U);
+		TEST_ASSERT(std::any_cast<big>(&a) == nullptr);
+
+		std::any b = big(4U);
+		TEST_ASSERT(std::any_cast<big&>(b).bytes[0] == 4U);
+		TEST_ASSERT(small::live == 1 && big::live == 1);
+
+		a.swap(b);
+		TEST_ASSERT(std::any_cast<big>(&a)->bytes[0] == 4U);
+		TEST_ASSERT(std::any_cast<small>(&b)->bytes[0] == 3U);
+
+		std::any c = a;
+		TEST_ASSERT(big::live == 2);
+		c.emplace<small>(static_cast<unsigned char>(9U));
+		TEST_ASSERT(big::live == 1 && std::any_cast<small>(c).bytes[0] == 9U);
+
+		std::any d = std::move(c);
+		TEST_ASSERT(std::any_cast<small>(&d) != nullptr);
+
+		a.reset();
+		TEST_ASSERT(!a.has_value() && big::live == 0);
+
+		std::any i = std::make_any<int>(42);
+		TEST_ASSERT(std::any_cast<int>(i) == 42);
+		i = 1.5;
+		TEST_ASSERT(std::any_cast<double>(&i) != nullptr && std::any_cast<int>(&i) == nullptr);
+	}
+	TEST_ASSERT(small::live == 0 && big::live == 0);
+}
+
+void
+test_basic_any()
+{
+	using any8 = __gnu_cxx::basic_any<8U>;
+	{
+		any8 a = tracked<8U>(1U);
+		any8 b = big(2U);
+		TEST_ASSERT(__gnu_cxx::any_cast<tracked<8U>>(&a)->bytes[0] == 1U);
+		TEST_ASSERT(__gnu_cxx::any_cast<big>(&b)->bytes[0] == 2U);
+
+		any8 c = b;
+		swap(a, c);
+		TEST_ASSERT(__gnu_cxx::any_cast<big>(&a) != nullptr);
+		TEST_ASSERT(__gnu_cxx::any_cast<tracked<8U>>(&c) != nullptr);
+		TEST_ASSERT(big::live == 2 && tracked<8U>::live == 1);
+	}
+	TEST_ASSERT(big::live == 0 && tracked<8U>::live == 0);
+}
+
+void
+test_inplace_any()
+{
+	using any8 = __gnu_cxx::inplace_any<8U>;
+
+	static_assert(std::is_constructible_v<any8, tracked<8U>>);
+	static_assert(!std::is_constructible_v<any8, big>);
+	static_assert(!std::is_assignable_v<any8&, big>);
+	{
+		any8 a;
+		TEST_ASSERT(!a.has_value());
+		a = std::uint32_t(42U);
+		TEST_ASSERT(*__gnu_cxx::any_cast<std::uint32_t>(&a) == 42U);
+		// A type that cannot be stored is never the contained one.
+		TEST_ASSERT(__gnu_cxx::any_cast<big>(&a) == nullptr);
+
+		a.emplace<small>(static_cast<unsigned char>(7U));
+		any8 b = a;
+		any8 c = std::move(a);
+		TEST_ASSERT(small::live == 2 && !a.has_value());
+		TEST_ASSERT(__gnu_cxx::any_cast<small&>(b).bytes[0] == 7U);
+		TEST_ASSERT(__gnu_cxx::any_cast<small>(c).bytes[0] == 7U);
+
+		b.reset();
+		TEST_ASSERT(!b.has_value());
+	}
+	TEST_ASSERT(small::live == 0);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_any();
+	test_basic_any();
+	test_inplace_any();
+	return 0;
+}
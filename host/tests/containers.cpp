@@ -0,0 +1,267 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <algorithm>
+#include <bitset>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t count = 300U;
+
+// A value that counts its live instances, to find leaks and double
+// destruction in the containers.
+struct tracked
+{
+	static int live;
+
+	std::uint16_t value;
+
+	tracked(std::uint16_t v = 0U) : value(v) { ++live; }
+	tracked(const tracked& other) : value(other.value) { ++live; }
+	~tracked() { --live; }
+
+	tracked& operator=(const tracked&) = default;
+
+	bool operator==(const tracked& other) const { return value == other.value; }
+	bool operator<(const tracked& other) const { return value < other.value; }
+};
+
+int tracked::live = 0;
+
+void
+test_vector()
+{
+	{
+		std::vector<tracked> v;
+		for(std::size_t i = 0U; i < count; ++i)
+		{
+			v.emplace_back(static_cast<std::uint16_t>(i));
+		}
+		TEST_ASSERT(v.size() == count);
+		TEST_ASSERT(v.capacity() >= count);
+		TEST_ASSERT(tracked::live == static_cast<int>(count));
+
+		v.insert(v.begin() + 10, tracked(1000U));
+		TEST_ASSERT(v[10].value == 1000U && v[11].value == 10U);
+		v.erase(v.begin(), v.begin() + 5);
+		TEST_ASSERT(v.front().value == 5U && v.size() == count - 4U);
+
+		v.resize(20U);
+		TEST_ASSERT(v.size() == 20U && v.back().value == 23U);
+		v.shrink_to_fit();
+		TEST_ASSERT(tracked::live == 20);
+
+		std::vector<tracked> w(v);
+		TEST_ASSERT(w == v);
+		w.assign(3U, tracked(7U));
+		TEST_ASSERT(w.size() == 3U && w[2].value == 7U);
+		w.swap(v);
+		TEST_ASSERT(v.size() == 3U && w.size() == 20U);
+	}
+	TEST_ASSERT(tracked::live == 0);
+}
+
+void
+test_deque()
+{
+	{
+		std::deque<tracked> d;
+		for(std::size_t i = 0U; i < count; ++i)
+		{
+			if(i % 2U)
+			{
+				d.emplace_back(static_cast<std::uint16_t>(i));
+			}
+			else
+			{
+				d.emplace_front(static_cast<std::uint16_t>(i));
+			}
+		}
+		TEST_ASSERT(d.size() == count);
+		TEST_ASSERT(d.front().value == count - 2U && d.back().value == count - 1U);
+		for(std::size_t i = 1U; i < d.size(); ++i)
+		{
+			// Even values descend to the middle, odd values ascend after it.
+			const bool front_half = i < count / 2U;
+			TEST_ASSERT(front_half ? d[i].value < d[i - 1U].value
+			                       : d[i].value > d[i - 1U].value || i == count / 2U);
+		}
+		while(d.size() > 10U)
+		{
+			d.pop_front();
+			d.pop_back();
+		}
+		TEST_ASSERT(tracked::live == 10);
+		d.insert(d.begin() + 5, 3U, tracked(9U));
+		TEST_ASSERT(d.size() == 13U && d[6].value == 9U);
+	}
+	TEST_ASSERT(tracked::live == 0);
+}
+
+void
+test_lists()
+{
+	{
+		std::list<tracked> l;
+		std::forward_list<tracked> f;
+		for(std::size_t i = 0U; i < count; ++i)
+		{
+			const auto v = static_cast<std::uint16_t>(test::random() % 64U);
+			l.push_back(v);
+			f.push_front(v);
+		}
+		l.sort();
+		f.sort();
+		TEST_ASSERT(std::is_sorted(l.begin(), l.end()));
+		TEST_ASSERT(std::equal(l.begin(), l.end(), f.begin()));
+
+		l.unique();
+		f.unique();
+		TEST_ASSERT(std::adjacent_find(l.begin(), l.end()) == l.end());
+		TEST_ASSERT(std::equal(l.begin(), l.end(), f.begin(), f.end()));
+
+		l.remove_if([](const tracked& t) { return t.value % 2U; });
+		TEST_ASSERT(std::all_of(l.begin(), l.end(),
+		                        [](const tracked& t) { return t.value % 2U == 0U; }));
+
+		std::list<tracked> m(l);
+		l.merge(m);
+		TEST_ASSERT(m.empty() && std::is_sorted(l.begin(), l.end()));
+		l.reverse();
+		TEST_ASSERT(std::is_sorted(l.rbegin(), l.rend()));
+	}
+	TEST_ASSERT(tracked::live == 0);
+}
+
+void
+test_trees()
+{
+	std::map<std::uint16_t, std::uint16_t> m;
+	std::set<std::uint16_t> s;
+	bool present[256] = {};
+
+	for(std::size_t i = 0U; i < 4U * count; ++i)
+	{
+		const auto k = static_cast<std::uint16_t>(test::random() % 256U);
+		if(test::random() % 3U)
+		{
+			const bool inserted = s.insert(k).second;
+			TEST_ASSERT(inserted != present[k]);
+			m[k] = static_cast<std::uint16_t>(k * 3U);
+			present[k] = true;
+		}
+		else
+		{
+			TEST_ASSERT(s.erase(k) == (present[k] ? 1U : 0U));
+			TEST_ASSERT(m.erase(k) == (present[k] ? 1U : 0U));
+			present[k] = false;
+		}
+	}
+
+	std::size_t n = 0U;
+	for(std::uint16_t k = 0U; k < 256U; ++k)
+	{
+		n += present[k];
+		TEST_ASSERT(s.count(k) == present[k]);
+		const auto it = m.find(k);
+		TEST_ASSERT((it != m.end()) == present[k]);
+		TEST_ASSERT(it == m.end() || it->second == k * 3U);
+	}
+	TEST_ASSERT(s.size() == n && m.size() == n);
+	TEST_ASSERT(std::is_sorted(s.begin(), s.end()));
+
+	const auto lb = s.lower_bound(100U);
+	TEST_ASSERT(lb == s.end() || *lb >= 100U);
+	TEST_ASSERT(lb == s.begin() || *std::prev(lb) < 100U);
+
+	std::map<std::uint16_t, std::uint16_t> copy(m);
+	TEST_ASSERT(copy == m);
+	copy.clear();
+	TEST_ASSERT(copy.empty() && copy.begin() == copy.end());
+}
+
+void
+test_hashed()
+{
+	std::unordered_map<std::uint16_t, std::uint16_t> m;
+	std::unordered_set<std::uint16_t> s;
+
+	for(std::uint16_t k = 0U; k < count; ++k)
+	{
+		m.emplace(static_cast<std::uint16_t>(k * 7U), k);
+		s.insert(static_cast<std::uint16_t>(k * 7U));
+	}
+	TEST_ASSERT(m.size() == count && s.size() == count);
+	TEST_ASSERT(m.load_factor() <= m.max_load_factor());
+
+	for(std::uint16_t k = 0U; k < 7U * count; ++k)
+	{
+		const bool expected = k % 7U == 0U;
+		TEST_ASSERT(s.count(k) == expected);
+		const auto it = m.find(k);
+		TEST_ASSERT((it != m.end()) == expected);
+		TEST_ASSERT(it == m.end() || it->second * 7U == k);
+	}
+
+	for(std::uint16_t k = 0U; k < count; k += 2U)
+	{
+		TEST_ASSERT(m.erase(static_cast<std::uint16_t>(k * 7U)) == 1U);
+	}
+	TEST_ASSERT(m.size() == count / 2U);
+
+	std::size_t visited = 0U;
+	for(const auto& kv : m)
+	{
+		TEST_ASSERT(kv.second % 2U == 1U);
+		++visited;
+	}
+	TEST_ASSERT(visited == m.size());
+
+	m.rehash(0U);
+	TEST_ASSERT(m.count(7U) == 1U && m.count(0U) == 0U);
+}
+
+void
+test_bitset()
+{
+	std::bitset<70> b;
+	TEST_ASSERT(b.none());
+	b.set(0).set(33).set(69);
+	TEST_ASSERT(b.count() == 3U && b.test(33) && !b.test(34));
+	TEST_ASSERT((b << 1).test(34) && !(b << 1).test(0));
+	TEST_ASSERT((b >> 33).test(0) && (b >> 33).test(36));
+	b.flip();
+	TEST_ASSERT(b.count() == 67U);
+	TEST_ASSERT(std::bitset<16>(0xa5a5UL).to_ulong() == 0xa5a5UL);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_vector();
+	test_deque();
+	test_lists();
+	test_trees();
+	test_hashed();
+	test_bitset();
+	return 0;
+}
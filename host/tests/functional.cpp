@@ -0,0 +1,189 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <ext/inplace_function.h>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace
+{
+
+int
+twice(int x)
+{ return 2 * x; }
+
+struct counter
+{
+	int total = 0;
+
+	int add(int x) { return total += x; }
+	int get() const { return total; }
+};
+
+// A callable that counts its live copies, to find leaked or doubly
+// destroyed targets.
+struct tracked
+{
+	static int live;
+
+	int offset;
+
+	explicit tracked(int o) : offset(o) { ++live; }
+	tracked(const tracked& other) : offset(other.offset) { ++live; }
+	tracked(tracked&& other) noexcept : offset(other.offset) { ++live; }
+	~tracked() { --live; }
+
+	int operator()(int x) const { return x + offset; }
+};
+
+int tracked::live = 0;
+
+// Larger than any in-place buffer, so that it is allocated where allowed.
+struct large
+{
+	int values[16] = {};
+
+	int operator()(int x) const { return x + values[15]; }
+};
+
+void
+test_function()
+{
+	{
+		std::function<int(int)> f = twice;
+		TEST_ASSERT(f(4) == 8);
+		f = tracked(3);
+		TEST_ASSERT(f(4) == 7 && tracked::live == 1);
+		std::function<int(int)> g = f;
+		TEST_ASSERT(g(1) == 4 && tracked::live == 2);
+
+		large l;
+		l.values[15] = 100;
+		f = l;
+		TEST_ASSERT(f(1) == 101 && tracked::live == 1);
+		std::swap(f, g);
+		TEST_ASSERT(f(1) == 4 && g(1) == 101);
+		g = nullptr;
+		TEST_ASSERT(!g);
+	}
+	TEST_ASSERT(tracked::live == 0);
+}
+
+void
+test_inplace_function()
+{
+	{
+		__gnu_cxx::inplace_function<int(int), 2U * sizeof(void*)> f = tracked(5);
+		TEST_ASSERT(f && f(1) == 6 && tracked::live == 1);
+
+		auto g = f;
+		TEST_ASSERT(g(2) == 7 && tracked::live == 2);
+
+		// Converting to a larger capacity keeps a single level of calls.
+		__gnu_cxx::inplace_function<int(int), 8U * sizeof(void*)> h = std::move(g);
+		TEST_ASSERT(h(3) == 8);
+
+		counter c;
+		__gnu_cxx::inplace_function<int(int)> add = [&c](int x) { return c.add(x); };
+		add(2);
+		add(3);
+		TEST_ASSERT(c.total == 5);
+
+		f = twice;
+		TEST_ASSERT(f(21) == 42);
+		f = nullptr;
+		TEST_ASSERT(!f);
+	}
+	TEST_ASSERT(tracked::live == 0);
+}
+
+int
+call(std::function_ref<int(int)> f, int x)
+{ return f(x); }
+
+void
+test_function_ref()
+{
+	TEST_ASSERT(call(twice, 5) == 10);
+
+	int base = 10;
+	auto add_base = [&base](int x) { return x + base; };
+	TEST_ASSERT(call(add_base, 1) == 11);
+	base = 20;
+	TEST_ASSERT(call(add_base, 1) == 21);
+
+	large l;
+	l.values[15] = 7;
+	TEST_ASSERT(call(l, 1) == 8);
+
+	counter c;
+	std::function_ref<int(int)> add(std::nontype<&counter::add>, c);
+	add(4);
+	add(5);
+	TEST_ASSERT(c.total == 9);
+
+	std::function_ref<int(const counter&)> get(std::nontype<&counter::get>);
+	TEST_ASSERT(get(c) == 9);
+
+	std::function_ref<int(int)> copy = add;
+	copy(1);
+	TEST_ASSERT(c.total == 10);
+	static_assert(std::is_trivially_copyable_v<std::function_ref<int(int)>>);
+}
+
+void
+test_move_only_function()
+{
+	{
+		std::move_only_function<int(int)> f;
+		TEST_ASSERT(!f);
+
+		auto owned = std::make_unique<int>(3);
+		f = [p = std::move(owned)](int x) { return x * *p; };
+		TEST_ASSERT(f && f(2) == 6);
+
+		std::move_only_function<int(int)> g = std::move(f);
+		TEST_ASSERT(g(3) == 9);
+
+		g = tracked(1);
+		TEST_ASSERT(g(1) == 2 && tracked::live == 1);
+
+		large l;
+		l.values[15] = 50;
+		std::move_only_function<int(int) const> h = l;
+		TEST_ASSERT(h(1) == 51);
+
+		std::move_only_function<int(int) noexcept> n = [](int x) noexcept { return -x; };
+		TEST_ASSERT(n(5) == -5);
+
+		std::move_only_function<int(int) &&> once = tracked(10);
+		TEST_ASSERT(std::move(once)(1) == 11 && tracked::live == 2);
+
+		swap(g, f);
+		TEST_ASSERT(!g && f(2) == 3);
+		f = nullptr;
+		TEST_ASSERT(tracked::live == 1);
+	}
+	TEST_ASSERT(tracked::live == 0);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_function();
+	test_inplace_function();
+	test_function_ref();
+	test_move_only_function();
+	return 0;
+}
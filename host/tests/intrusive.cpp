@@ -0,0 +1,200 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <algorithm>
+#include <ext/ilist.h>
+#include <ext/iset.h>
+#include <iterator>
+
+namespace
+{
+
+constexpr std::size_t pool_size = 64U;
+
+// An object that is in two lists and two trees at once.
+struct job
+{
+	std::uint16_t id = 0U;
+	std::uint16_t priority = 0U;
+	__gnu_cxx::ilist_hook ready_hook;
+	__gnu_cxx::ilist_hook owner_hook;
+	__gnu_cxx::iset_hook by_id;
+	__gnu_cxx::iset_hook by_priority;
+
+	bool operator<(const job& other) const { return priority < other.priority; }
+};
+
+job pool[pool_size];
+
+using ready_list = __gnu_cxx::ilist<job, &job::ready_hook>;
+using owner_list = __gnu_cxx::ilist<job, &job::owner_hook>;
+using id_map = __gnu_cxx::imap<std::uint16_t, job, &job::by_id, &job::id>;
+using priority_set = __gnu_cxx::iset<job, &job::by_priority>;
+
+void
+reset_pool()
+{
+	for(std::size_t i = 0U; i < pool_size; ++i)
+	{
+		pool[i].id = static_cast<std::uint16_t>(i);
+		pool[i].priority = static_cast<std::uint16_t>((i * 37U) % pool_size);
+	}
+}
+
+void
+test_ilist()
+{
+	reset_pool();
+	{
+		ready_list ready;
+		owner_list even;
+		for(job& j : pool)
+		{
+			ready.push_back(j);
+			if(j.id % 2U == 0U)
+			{
+				even.push_front(j);
+			}
+		}
+		TEST_ASSERT(ready.size() == pool_size && even.size() == pool_size / 2U);
+		TEST_ASSERT(&ready.front() == &pool[0] && &even.front() == &pool[pool_size - 2U]);
+		TEST_ASSERT(pool[3].ready_hook.is_linked() && !pool[3].owner_hook.is_linked());
+
+		// Unlink through the object, without searching.
+		ready.erase(ready.iterator_to(pool[5]));
+		TEST_ASSERT(!pool[5].ready_hook.is_linked() && ready.size() == pool_size - 1U);
+		TEST_ASSERT(std::next(ready.iterator_to(pool[4]))->id == 6U);
+
+		TEST_ASSERT(ready.remove_if([](const job& j) { return j.id >= 32U; }) == 32U);
+		TEST_ASSERT(ready.size() == 31U && &ready.back() == &pool[31]);
+		TEST_ASSERT(even.size() == pool_size / 2U);
+
+		ready.sort([](const job& a, const job& b) { return a.priority < b.priority; });
+		TEST_ASSERT(std::is_sorted(ready.begin(), ready.end(),
+		                           [](const job& a, const job& b) { return a.priority < b.priority; }));
+
+		ready_list other;
+		other.splice(other.end(), ready, ready.begin(), std::next(ready.begin(), 10));
+		TEST_ASSERT(other.size() == 10U && ready.size() == 21U);
+		other.reverse();
+		ready.splice(ready.begin(), other);
+		TEST_ASSERT(other.empty() && ready.size() == 31U);
+
+		ready.pop_front();
+		ready.pop_back();
+		TEST_ASSERT(ready.size() == 29U);
+
+		ready_list moved(std::move(ready));
+		TEST_ASSERT(ready.empty() && moved.size() == 29U);
+		TEST_ASSERT(static_cast<std::size_t>(std::distance(moved.rbegin(), moved.rend())) == 29U);
+	}
+	// The lists unlinked everything when they were destroyed.
+	for(const job& j : pool)
+	{
+		TEST_ASSERT(!j.ready_hook.is_linked() && !j.owner_hook.is_linked());
+	}
+}
+
+void
+test_imap()
+{
+	reset_pool();
+	{
+		id_map by_id;
+		bool linked[pool_size] = {};
+		for(std::size_t i = 0U; i < 4U * pool_size; ++i)
+		{
+			const std::size_t k = test::random() % pool_size;
+			if(test::random() % 2U)
+			{
+				// A linked object must not be inserted again.
+				if(!linked[k])
+				{
+					const auto r = by_id.insert(pool[k]);
+					TEST_ASSERT(r.second && &*r.first == &pool[k]);
+					linked[k] = true;
+				}
+			}
+			else
+			{
+				TEST_ASSERT(by_id.erase(static_cast<std::uint16_t>(k)) == (linked[k] ? 1U : 0U));
+				linked[k] = false;
+			}
+		}
+
+		std::size_t n = 0U;
+		for(std::uint16_t k = 0U; k < pool_size; ++k)
+		{
+			n += linked[k];
+			TEST_ASSERT(by_id.contains(k) == linked[k]);
+			TEST_ASSERT(pool[k].by_id.is_linked() == linked[k]);
+			const auto it = by_id.find(k);
+			TEST_ASSERT(it == by_id.end() ? !linked[k] : &*it == &pool[k]);
+		}
+		TEST_ASSERT(by_id.size() == n);
+		TEST_ASSERT(std::is_sorted(by_id.begin(), by_id.end(),
+		                           [](const job& a, const job& b) { return a.id < b.id; }));
+
+		const auto lb = by_id.lower_bound(20U);
+		TEST_ASSERT(lb == by_id.end() || lb->id >= 20U);
+		TEST_ASSERT(lb == by_id.begin() || std::prev(lb)->id < 20U);
+
+		by_id.erase(by_id.begin(), by_id.lower_bound(32U));
+		TEST_ASSERT(by_id.empty() || by_id.begin()->id >= 32U);
+	}
+	for(const job& j : pool)
+	{
+		TEST_ASSERT(!j.by_id.is_linked());
+	}
+}
+
+void
+test_iset()
+{
+	reset_pool();
+	priority_set by_priority;
+	for(job& j : pool)
+	{
+		TEST_ASSERT(by_priority.insert(j).second);
+	}
+	// Priorities are a permutation, so a second job with one is rejected.
+	job duplicate;
+	duplicate.priority = 5U;
+	const auto r = by_priority.insert(duplicate);
+	TEST_ASSERT(!r.second && r.first->priority == 5U && !duplicate.by_priority.is_linked());
+
+	std::uint16_t expected = 0U;
+	for(const job& j : by_priority)
+	{
+		TEST_ASSERT(j.priority == expected++);
+	}
+	TEST_ASSERT(by_priority.count(pool[9]) == 1U);
+
+	by_priority.erase(by_priority.iterator_to(pool[9]));
+	TEST_ASSERT(!pool[9].by_priority.is_linked() && by_priority.count(pool[9]) == 0U);
+	by_priority.clear();
+	TEST_ASSERT(by_priority.empty());
+	for(const job& j : pool)
+	{
+		TEST_ASSERT(!j.by_priority.is_linked());
+	}
+}
+
+} // namespace
+
+int
+main()
+{
+	test_ilist();
+	test_imap();
+	test_iset();
+	return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <ext/intrusive_ptr.h>
+#include <memory>
+#include <utility>
+
+namespace
+{
+
+struct base
+{
+	static int live;
+
+	int value;
+
+	explicit base(int v = 0) : value(v) { ++live; }
+	virtual ~base() { --live; }
+};
+
+int base::live = 0;
+
+struct derived : base
+{
+	int extra = 7;
+
+	explicit derived(int v) : base(v) {}
+};
+
+// Counts the allocations made through it, to check that allocate_shared
+// puts the object and its control block into a single one.
+template<typename T>
+struct counting_allocator
+{
+	using value_type = T;
+
+	static int allocations;
+	static int deallocations;
+
+	counting_allocator() = default;
+	template<typename U>
+	counting_allocator(const counting_allocator<U>&) noexcept {}
+
+	T*
+	allocate(std::size_t n)
+	{
+		++counting_allocator<char>::allocations;
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void
+	deallocate(T* p, std::size_t)
+	{
+		++counting_allocator<char>::deallocations;
+		::operator delete(p);
+	}
+
+	template<typename U>
+	bool operator==(const counting_allocator<U>&) const { return true; }
+	template<typename U>
+	bool operator!=(const counting_allocator<U>&) const { return false; }
+};
+
+template<typename T>
+int counting_allocator<T>::allocations = 0;
+template<typename T>
+int counting_allocator<T>::deallocations = 0;
+
+void
+test_shared_ptr()
+{
+	{
+		std::shared_ptr<base> p(new derived(3));
+		TEST_ASSERT(p.use_count() == 1 && p->value == 3);
+
+		std::shared_ptr<base> q = p;
+		TEST_ASSERT(p.use_count() == 2 && q.get() == p.get());
+
+		std::shared_ptr<base> r = std::move(q);
+		TEST_ASSERT(!q && r.use_count() == 2);
+
+		auto d = std::static_pointer_cast<derived>(r);
+		TEST_ASSERT(d->extra == 7 && p.use_count() == 3);
+
+		// The aliasing constructor shares ownership of the whole object.
+		std::shared_ptr<int> member(p, &d->extra);
+		TEST_ASSERT(*member == 7 && p.use_count() == 4);
+
+		p.reset();
+		r.reset();
+		d.reset();
+		TEST_ASSERT(base::live == 1 && member.use_count() == 1);
+	}
+	TEST_ASSERT(base::live == 0);
+
+	// A deleter is called exactly once, with the original pointer.
+	static int deleted = 0;
+	{
+		std::shared_ptr<int> p(new int(5), [](int* i) { ++deleted; delete i; });
+		std::shared_ptr<int> q = p;
+		TEST_ASSERT(deleted == 0);
+	}
+	TEST_ASSERT(deleted == 1);
+
+	std::shared_ptr<int> empty;
+	TEST_ASSERT(!empty && empty.use_count() == 0);
+	std::shared_ptr<int> null(nullptr);
+	TEST_ASSERT(!null && null == nullptr);
+}
+
+void
+test_weak_ptr()
+{
+	std::weak_ptr<base> w;
+	TEST_ASSERT(w.expired() && !w.lock());
+	{
+		auto p = std::make_shared<derived>(9);
+		w = p;
+		TEST_ASSERT(!w.expired() && w.use_count() == 1);
+
+		std::weak_ptr<base> w2 = w;
+		auto locked = w2.lock();
+		TEST_ASSERT(locked && locked->value == 9 && p.use_count() == 2);
+	}
+	TEST_ASSERT(w.expired() && !w.lock() && base::live == 0);
+	w.reset();
+}
+
+struct node : std::enable_shared_from_this<node>
+{
+	int value = 1;
+};
+
+void
+test_make_shared()
+{
+	{
+		auto p = std::make_shared<node>();
+		auto self = p->shared_from_this();
+		TEST_ASSERT(self == p && p.use_count() == 2);
+		std::weak_ptr<node> weak = p->weak_from_this();
+		TEST_ASSERT(weak.lock() == p);
+	}
+
+	{
+		counting_allocator<derived> alloc;
+		auto p = std::allocate_shared<derived>(alloc, 4);
+		TEST_ASSERT(counting_allocator<char>::allocations == 1);
+		TEST_ASSERT(p->value == 4 && base::live == 1);
+
+		std::weak_ptr<derived> w = p;
+		p.reset();
+		// The object is gone, the block stays for the weak_ptr.
+		TEST_ASSERT(base::live == 0 && counting_allocator<char>::deallocations == 0);
+	}
+	TEST_ASSERT(counting_allocator<char>::deallocations == 1);
+}
+
+// An object from a static pool that keeps its own count and goes back to
+// the pool when the last pointer to it is gone.
+struct pooled
+{
+	unsigned char refs = 0U;
+	bool in_use = false;
+};
+
+pooled pool[4];
+
+void
+intrusive_ptr_add_ref(pooled* p)
+{ ++p->refs; }
+
+void
+intrusive_ptr_release(pooled* p)
+{
+	if(--p->refs == 0U)
+	{
+		p->in_use = false;
+	}
+}
+
+struct counted : __gnu_cxx::intrusive_ref_counter<counted>
+{
+	static int live;
+
+	counted() { ++live; }
+	counted(const counted& other) : intrusive_ref_counter(other) { ++live; }
+	~counted() { --live; }
+};
+
+int counted::live = 0;
+
+void
+test_intrusive_ptr()
+{
+	pool[1].in_use = true;
+	{
+		__gnu_cxx::intrusive_ptr<pooled> p(&pool[1]);
+		TEST_ASSERT(pool[1].refs == 1U);
+		{
+			auto q = p;
+			__gnu_cxx::intrusive_ptr<pooled> r(std::move(q));
+			TEST_ASSERT(!q && pool[1].refs == 2U);
+		}
+		TEST_ASSERT(pool[1].refs == 1U && pool[1].in_use);
+
+		pooled* raw = p.detach();
+		TEST_ASSERT(!p && raw->refs == 1U);
+		p.reset(raw, false);
+		TEST_ASSERT(p.get() == raw && raw->refs == 1U);
+	}
+	TEST_ASSERT(pool[1].refs == 0U && !pool[1].in_use);
+
+	{
+		__gnu_cxx::intrusive_ptr<counted> p(new counted);
+		auto q = p;
+		TEST_ASSERT(p->use_count() == 2U && p == q);
+		q.reset();
+		TEST_ASSERT(p->use_count() == 1U && counted::live == 1);
+
+		// Copying the object does not copy its count.
+		counted copy(*p);
+		TEST_ASSERT(copy.use_count() == 0U);
+	}
+	TEST_ASSERT(counted::live == 0);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_shared_ptr();
+	test_weak_ptr();
+	test_make_shared();
+	test_intrusive_ptr();
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#include <expected>
+#include <ext/compact_optional.h>
+#include <optional>
+#include <utility>
+
+enum class error : std::uint8_t { none, timeout, checksum };
+
+template<>
+struct __gnu_cxx::niche_traits<error>
+{ static constexpr error niche = error::none; };
+
+namespace
+{
+
+void
+test_compact_optional()
+{
+	using reading = __gnu_cxx::compact_optional<std::uint8_t, __gnu_cxx::niche_value<0xff>>;
+	static_assert(sizeof(reading) == 1U);
+
+	reading r;
+	TEST_ASSERT(!r.has_value() && !r && r == std::nullopt);
+	TEST_ASSERT(r.value_or(3U) == 3U);
+
+	r = 7U;
+	TEST_ASSERT(r && *r == 7U && r.value() == 7U && r == 7U);
+	TEST_ASSERT(r.to_optional() == std::optional<std::uint8_t>(7U));
+
+	reading s(std::optional<std::uint8_t>(9U));
+	TEST_ASSERT(s > r && s != r);
+	r.swap(s);
+	TEST_ASSERT(*r == 9U && *s == 7U);
+
+	s.reset();
+	TEST_ASSERT(!s && s < r && s.to_optional() == std::nullopt);
+	s.emplace(static_cast<std::uint8_t>(0U));
+	TEST_ASSERT(s.has_value() && *s == 0U);
+
+	int target = 5;
+	__gnu_cxx::compact_optional<int*, __gnu_cxx::niche_value<nullptr>> p;
+	static_assert(sizeof(p) == sizeof(int*));
+	TEST_ASSERT(!p);
+	p = &target;
+	TEST_ASSERT(p && **p == 5);
+
+	__gnu_cxx::compact_optional<error> e;
+	static_assert(sizeof(e) == 1U);
+	TEST_ASSERT(!e);
+	e = error::checksum;
+	TEST_ASSERT(e == error::checksum);
+}
+
+std::expected<std::uint16_t, error>
+parse(int x)
+{
+	if(x < 0)
+	{
+		return std::unexpected(error::timeout);
+	}
+	return static_cast<std::uint16_t>(x);
+}
+
+std::expected<void, error>
+check(int x)
+{
+	if(x % 2)
+	{
+		return std::unexpected(error::checksum);
+	}
+	return {};
+}
+
+void
+test_expected()
+{
+	static_assert(sizeof(std::expected<std::uint16_t, error>) <= 2U * sizeof(std::uint16_t));
+	static_assert(sizeof(std::expected<void, error>) == sizeof(error));
+
+	auto good = parse(5);
+	auto bad = parse(-1);
+	TEST_ASSERT(good && *good == 5U && good.value() == 5U);
+	TEST_ASSERT(!bad && bad.error() == error::timeout);
+	TEST_ASSERT(bad.value_or(1U) == 1U);
+
+	auto doubled = good.transform([](std::uint16_t v) { return 2 * v; });
+	TEST_ASSERT(*doubled == 10);
+	auto chained = good.and_then([](std::uint16_t v) { return parse(-static_cast<int>(v)); });
+	TEST_ASSERT(!chained && chained.error() == error::timeout);
+	auto recovered = bad.or_else([](error) { return parse(1); });
+	TEST_ASSERT(*recovered == 1U);
+	auto mapped = bad.transform_error([](error e) { return static_cast<int>(e) + 10; });
+	TEST_ASSERT(mapped.error() == 11);
+
+	TEST_ASSERT(check(2).has_value());
+	TEST_ASSERT(check(3).error() == error::checksum);
+	auto v = check(4).and_then([] { return check(5); });
+	TEST_ASSERT(!v && v.error() == error::checksum);
+
+	std::expected<std::uint16_t, error> e = std::unexpected(error::checksum);
+	e = 3U;
+	TEST_ASSERT(e && *e == 3U);
+	e.emplace(static_cast<std::uint16_t>(4U));
+	TEST_ASSERT(e == 4U && e != std::unexpected(error::timeout));
+	swap(e, bad);
+	TEST_ASSERT(!e && *bad == 4U);
+}
+
+void
+test_optional()
+{
+	std::optional<std::uint16_t> o;
+	TEST_ASSERT(!o);
+	o.emplace(static_cast<std::uint16_t>(3U));
+	TEST_ASSERT(o && *o == 3U && o.value_or(0U) == 3U);
+	std::optional<std::uint16_t> p = std::move(o);
+	TEST_ASSERT(p == o);
+	o.reset();
+	TEST_ASSERT(o < p && o == std::nullopt);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_compact_optional();
+	test_expected();
+	test_optional();
+	return 0;
+}
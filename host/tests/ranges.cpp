@@ -0,0 +1,241 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#include "test.h"
+
+#if __cplusplus > 201703L
+
+#include <algorithm>
+#include <array>
+#include <forward_list>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace
+{
+
+namespace views = std::views;
+
+void
+test_zip()
+{
+	std::array<int, 4> a{ 1, 2, 3, 4 };
+	std::list<char> b{ 'a', 'b', 'c' };
+
+	auto z = views::zip(a, b);
+	TEST_ASSERT(std::ranges::distance(z) == 3);
+	int sum = 0;
+	for(auto [x, c] : z)
+	{
+		sum += x * (c - 'a' + 1);
+	}
+	TEST_ASSERT(sum == 1 + 4 + 9);
+
+	// Assigning through the proxy writes to the underlying ranges.
+	for(auto&& [x, c] : z)
+	{
+		x = c;
+	}
+	TEST_ASSERT(a[0] == 'a' && a[2] == 'c' && a[3] == 4);
+
+	auto same = views::zip(a, a);
+	static_assert(std::ranges::sized_range<decltype(same)>);
+	static_assert(std::ranges::borrowed_range<decltype(views::zip(std::span(a)))>);
+	TEST_ASSERT(same.size() == 4U);
+	TEST_ASSERT(std::ranges::equal(same | views::reverse | views::transform([](auto t) { return std::get<0>(t); }),
+	                               a | views::reverse));
+}
+
+void
+test_enumerate()
+{
+	std::forward_list<int> l{ 5, 6, 7 };
+	std::size_t n = 0U;
+	for(auto [i, v] : views::enumerate(l))
+	{
+		TEST_ASSERT(static_cast<std::size_t>(i) == n && v == static_cast<int>(5U + n));
+		++n;
+	}
+	TEST_ASSERT(n == 3U);
+}
+
+void
+test_adjacent()
+{
+	std::array<int, 5> a{ 1, 2, 4, 8, 16 };
+
+	std::vector<int> sums;
+	for(auto [x, y, z] : a | views::adjacent<3>)
+	{
+		sums.push_back(x + y + z);
+	}
+	TEST_ASSERT((sums == std::vector<int>{ 7, 14, 28 }));
+
+	int diffs = 0;
+	for(auto [x, y] : a | views::pairwise)
+	{
+		diffs += y - x;
+	}
+	TEST_ASSERT(diffs == 15);
+	std::array<int, 1> one{ 1 };
+	TEST_ASSERT(std::ranges::empty(one | views::pairwise));
+	TEST_ASSERT((a | views::adjacent<5>).size() == 1U);
+	TEST_ASSERT((a | views::adjacent<6>).size() == 0U);
+}
+
+void
+test_chunk_slide_stride()
+{
+	std::vector<int> v(10);
+	std::iota(v.begin(), v.end(), 0);
+
+	std::vector<int> firsts, sizes;
+	for(auto c : v | views::chunk(4))
+	{
+		firsts.push_back(*c.begin());
+		sizes.push_back(static_cast<int>(std::ranges::distance(c)));
+	}
+	TEST_ASSERT((firsts == std::vector<int>{ 0, 4, 8 }));
+	TEST_ASSERT((sizes == std::vector<int>{ 4, 4, 2 }));
+	TEST_ASSERT(std::ranges::distance(*(v | views::chunk(4) | views::reverse).begin()) == 2);
+
+	std::list<int> l(v.begin(), v.end());
+	int windows = 0;
+	for(auto w : l | views::slide(3))
+	{
+		TEST_ASSERT(std::ranges::distance(w) == 3);
+		TEST_ASSERT(*std::ranges::next(w.begin(), 2) == *w.begin() + 2);
+		++windows;
+	}
+	TEST_ASSERT(windows == 8);
+	TEST_ASSERT((v | views::slide(11)).empty());
+
+	TEST_ASSERT(std::ranges::equal(v | views::stride(3), std::array<int, 4>{ 0, 3, 6, 9 }));
+	TEST_ASSERT(std::ranges::equal(v | views::stride(3) | views::reverse, std::array<int, 4>{ 9, 6, 3, 0 }));
+	TEST_ASSERT(std::ranges::equal(v | views::stride(4) | views::reverse, std::array<int, 3>{ 8, 4, 0 }));
+	TEST_ASSERT((v | views::stride(20)).size() == 1U);
+}
+
+void
+test_cartesian_product()
+{
+	std::array<int, 3> a{ 1, 2, 3 };
+	std::list<int> b{ 10, 20 };
+
+	auto p = views::cartesian_product(a, b);
+	TEST_ASSERT(std::ranges::distance(p) == 6);
+	int sum = 0;
+	int last = 0;
+	for(auto [x, y] : p)
+	{
+		sum += x * y;
+		last = x * 100 + y;
+	}
+	TEST_ASSERT(sum == (1 + 2 + 3) * (10 + 20));
+	TEST_ASSERT(last == 320);
+	std::vector<int> none;
+	TEST_ASSERT(std::ranges::empty(views::cartesian_product(a, none)));
+}
+
+void
+test_search()
+{
+	std::array<std::uint8_t, 8> bytes{ 1, 2, 3, 4, 3, 2, 1, 0 };
+	std::list<int> l{ 1, 2, 3, 2, 1 };
+
+	TEST_ASSERT(std::ranges::contains(bytes, 4));
+	TEST_ASSERT(!std::ranges::contains(bytes, 9));
+	TEST_ASSERT(std::ranges::contains(l, 3));
+	TEST_ASSERT(std::ranges::contains_subrange(bytes, std::array<int, 2>{ 3, 2 }));
+	TEST_ASSERT(!std::ranges::contains_subrange(l, std::array<int, 2>{ 3, 3 }));
+	TEST_ASSERT(std::ranges::find(bytes, 3) == bytes.begin() + 2);
+
+	auto found = std::ranges::find_last(bytes, 3);
+	TEST_ASSERT(found.begin() == bytes.begin() + 4 && found.end() == bytes.end());
+	TEST_ASSERT(std::ranges::find_last(l, 9).begin() == l.end());
+	TEST_ASSERT(*std::ranges::find_last_if(l, [](int x) { return x > 1; }).begin() == 2);
+	TEST_ASSERT(std::ranges::distance(std::ranges::find_last_if_not(l, [](int x) { return x < 3; })) == 3);
+
+	TEST_ASSERT(std::ranges::starts_with(bytes, std::array<std::uint8_t, 3>{ 1, 2, 3 }));
+	TEST_ASSERT(!std::ranges::starts_with(bytes, std::array<std::uint8_t, 2>{ 1, 3 }));
+	TEST_ASSERT(std::ranges::ends_with(bytes, std::array<std::uint8_t, 2>{ 1, 0 }));
+	TEST_ASSERT(std::ranges::ends_with(l, std::array<int, 2>{ 2, 1 }));
+	TEST_ASSERT(!std::ranges::ends_with(std::array<int, 1>{ 1 }, l));
+	TEST_ASSERT(std::ranges::starts_with(l, std::array<int, 0>{}));
+}
+
+void
+test_fold()
+{
+	std::array<int, 4> a{ 1, 2, 3, 4 };
+
+	TEST_ASSERT(std::ranges::fold_left(a, 0, std::plus<>()) == 10);
+	TEST_ASSERT(std::ranges::fold_left(a, 100, std::minus<>()) == 90);
+	TEST_ASSERT(std::ranges::fold_right(a, 100, std::minus<>()) == 1 - (2 - (3 - (4 - 100))));
+	TEST_ASSERT(*std::ranges::fold_left_first(a, std::multiplies<>()) == 24);
+	TEST_ASSERT(*std::ranges::fold_right_last(a, std::minus<>()) == 1 - (2 - (3 - 4)));
+	TEST_ASSERT(!std::ranges::fold_left_first(std::array<int, 0>{}, std::plus<>()).has_value());
+
+	auto r = std::ranges::fold_left_with_iter(a, 0, std::plus<>());
+	TEST_ASSERT(r.in == a.end() && r.value == 10);
+}
+
+void
+test_iota_shift()
+{
+	std::array<int, 8> a{};
+	auto r = std::ranges::iota(a, 1);
+	TEST_ASSERT(r.out == a.end() && r.value == 9);
+	TEST_ASSERT(a[0] == 1 && a[7] == 8);
+
+	auto left = std::ranges::shift_left(a, 3);
+	TEST_ASSERT(left.begin() == a.begin() && left.end() == a.begin() + 5);
+	TEST_ASSERT(a[0] == 4 && a[4] == 8);
+
+	std::ranges::iota(a, 1);
+	auto right = std::ranges::shift_right(a, 3);
+	TEST_ASSERT(right.begin() == a.begin() + 3 && right.end() == a.end());
+	TEST_ASSERT(a[3] == 1 && a[7] == 5);
+
+	TEST_ASSERT(std::ranges::shift_left(a, 8).empty());
+
+	std::list<int> l{ 1, 2, 3, 4 };
+	std::ranges::shift_right(l, 1);
+	TEST_ASSERT(*std::next(l.begin()) == 1 && l.back() == 3);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_zip();
+	test_enumerate();
+	test_adjacent();
+	test_chunk_slide_stride();
+	test_cartesian_product();
+	test_search();
+	test_fold();
+	test_iota_shift();
+	return 0;
+}
+
+#else
+
+int
+main()
+{
+	return 0;
+}
+
+#endif
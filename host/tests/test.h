@@ -0,0 +1,47 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef HOST_TESTS_TEST_H
+#define HOST_TESTS_TEST_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Report a failed check and exit with status 1. The tests are built
+// without exceptions; exiting instead of aborting keeps a failed check
+// apart from the aborts that the tests in abort/ expect.
+#define TEST_ASSERT(cond) \
+	((cond) ? static_cast<void>(0) : test::fail(#cond, __FILE__, __LINE__))
+
+namespace test
+{
+
+[[noreturn]] inline void
+fail(const char* cond, const char* file, int line)
+{
+	std::printf("%s:%d: check failed: %s\n", file, line, cond);
+	std::fflush(stdout);
+	std::exit(1);
+}
+
+// Deterministic 16-bit xorshift generator, as in the benchmarks.
+inline std::uint16_t
+random()
+{
+	static std::uint16_t state = 0xace1U;
+	state ^= static_cast<std::uint16_t>(state << 7U);
+	state ^= static_cast<std::uint16_t>(state >> 9U);
+	state ^= static_cast<std::uint16_t>(state << 8U);
+	return state;
+}
+
+} // namespace test
+
+#endif // HOST_TESTS_TEST_H
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+// Variants of up to MODM_VARIANT_VISIT_SWITCH alternatives dispatch with a
+// switch, larger ones and visits of several variants with a table;
+// variant_table.cpp runs the same tests with the switch disabled.
+
+#include "test.h"
+
+#include <utility>
+#include <variant>
+
+namespace
+{
+
+// Counts its live instances, to check that the special members of the
+// variant construct and destroy the right alternative.
+template<int N>
+struct alternative
+{
+	static int live;
+
+	int value;
+
+	explicit alternative(int v = N) : value(v) { ++live; }
+	alternative(const alternative& other) : value(other.value) { ++live; }
+	alternative(alternative&& other) noexcept : value(other.value) { ++live; }
+	~alternative() { --live; }
+	alternative& operator=(const alternative&) = default;
+	alternative& operator=(alternative&&) = default;
+
+	bool operator==(const alternative& other) const { return value == other.value; }
+	bool operator!=(const alternative& other) const { return value != other.value; }
+	bool operator<(const alternative& other) const { return value < other.value; }
+};
+
+template<int N>
+int alternative<N>::live = 0;
+
+template<int... N>
+int
+live(std::integer_sequence<int, N...>)
+{
+	int total = 0;
+	(void) std::initializer_list<int>{ (total += alternative<N>::live)... };
+	return total;
+}
+
+// The value of the alternative times 100 plus its index.
+struct visitor
+{
+	template<int N>
+	int operator()(const alternative<N>& a) const { return a.value * 100 + N; }
+};
+
+// Visit, copy, move, assign, compare and destroy every alternative of a
+// variant of N alternatives.
+template<int... N>
+void
+test_variant(std::integer_sequence<int, N...> seq)
+{
+	using variant = std::variant<alternative<N>...>;
+	constexpr int count = sizeof...(N);
+	{
+		variant v;
+		TEST_ASSERT(v.index() == 0U && std::visit(visitor(), v) == 0);
+
+		for(int i = 0; i < count; ++i)
+		{
+			// Assign each alternative in turn, from a variant built with
+			// an index known only at run time.
+			variant other;
+			int k = 0;
+			(void) std::initializer_list<int>{ (k++ == i ? (other.template emplace<N>(i + 1), 0) : 0)... };
+			TEST_ASSERT(other.index() == static_cast<std::size_t>(i));
+			TEST_ASSERT(std::visit(visitor(), other) == (i + 1) * 100 + i);
+
+			variant copy(other);
+			TEST_ASSERT(copy == other && !(copy < other));
+			v = copy;
+			TEST_ASSERT(v.index() == static_cast<std::size_t>(i));
+			variant moved(std::move(copy));
+			TEST_ASSERT(moved == v);
+			v = std::move(moved);
+			TEST_ASSERT(std::visit(visitor(), v) == (i + 1) * 100 + i);
+
+			if(i > 0)
+			{
+				variant first;
+				TEST_ASSERT(first < v && first != v);
+				swap(first, v);
+				TEST_ASSERT(first.index() == static_cast<std::size_t>(i) && v.index() == 0U);
+				swap(first, v);
+			}
+			// v, other, and copy and moved, which were moved from.
+			TEST_ASSERT(live(seq) == 4);
+		}
+
+		// Visiting two variants at once goes through a table.
+		variant w;
+		w.template emplace<count - 1>(5);
+		const int both = std::visit([](const auto& a, const auto& b) { return a.value * 1000 + b.value; }, v, w);
+		TEST_ASSERT(both == count * 1000 + 5);
+
+		// Visitors can modify the alternative.
+		std::visit([](auto& a) { a.value = 77; }, w);
+		TEST_ASSERT(std::get<count - 1>(w).value == 77);
+		TEST_ASSERT(std::holds_alternative<alternative<count - 1>>(w));
+		TEST_ASSERT(count == 1 || std::get_if<0>(&w) == nullptr);
+	}
+	TEST_ASSERT(live(seq) == 0);
+}
+
+} // namespace
+
+int
+main()
+{
+	test_variant(std::make_integer_sequence<int, 1>());
+	test_variant(std::make_integer_sequence<int, 2>());
+	test_variant(std::make_integer_sequence<int, 5>());
+	test_variant(std::make_integer_sequence<int, 11>());
+	test_variant(std::make_integer_sequence<int, 12>());
+	return 0;
+}
@@ -0,0 +1,13 @@
+/*
+ * This file is part of the modm project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+// ----------------------------------------------------------------------------
+
+// The tests of variant.cpp with every variant dispatching through a table.
+#define MODM_VARIANT_VISIT_SWITCH 0
+
+#include "variant.cpp"
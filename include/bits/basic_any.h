@@ -0,0 +1,492 @@
+// Type-safe container of any type with a given buffer -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/basic_any.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{any}
+ */
+
+#ifndef _BASIC_ANY_H
+#define _BASIC_ANY_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#if __cpp_rtti
+#include <typeinfo>
+#else
+namespace std
+{
+  class type_info;
+}
+#endif // __cpp_rtti
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template<std::size_t _Size, std::size_t _Align, bool _Allocate>
+    class basic_any;
+
+  template<typename _Tp, typename _Any>
+    void* __basic_any_caster(const _Any* __any);
+
+  /**
+   *  @brief A type-safe container of any type with an in-place buffer of
+   *  @a _Size bytes aligned to @a _Align.
+   *
+   *  Objects that do not fit into the buffer are allocated if
+   *  @a _Allocate is true, and rejected at compile time otherwise.
+   */
+  template<std::size_t _Size = sizeof(void*),
+	   std::size_t _Align = alignof(void*), bool _Allocate = true>
+    class basic_any
+    {
+      union _Storage
+      {
+	constexpr _Storage() : _M_ptr{nullptr} {}
+
+	// Prevent trivial copies of this type, buffer might hold a non-POD.
+	_Storage(const _Storage&) = delete;
+	_Storage& operator=(const _Storage&) = delete;
+
+	void* _M_ptr;
+	typename std::aligned_storage<_Size, _Align>::type _M_buffer;
+      };
+
+      template<typename _Tp,
+	       typename _Safe = std::is_nothrow_move_constructible<_Tp>,
+	       bool _Fits = (sizeof(_Tp) <= sizeof(_Storage))
+			    && (alignof(_Tp) <= alignof(_Storage))>
+	using _Internal = std::integral_constant<bool, _Safe::value && _Fits>;
+
+      template<typename _Tp>
+	struct _Manager_internal; // uses small-object optimization
+
+      template<typename _Tp>
+	struct _Manager_external; // creates contained object on the heap
+
+      template<typename _Tp>
+	using _Manager = std::conditional_t<_Internal<_Tp>::value,
+					    _Manager_internal<_Tp>,
+					    _Manager_external<_Tp>>;
+
+      // True if a _Tp can be stored, i.e. in place unless allocating.
+      // Constrains every way to store a value, so that traits such as
+      // is_constructible are false for a _Tp that does not fit.
+      template<typename _Tp>
+	static constexpr bool _S_storable = _Allocate || _Internal<_Tp>::value;
+
+      // Types derived from this one, such as std::any, are copied or
+      // moved instead of being stored.
+      template<typename _Tp, typename _VTp = std::decay_t<_Tp>>
+	using _Decay_if_not_any
+	  = std::enable_if_t<!std::is_base_of<basic_any, _VTp>::value, _VTp>;
+
+      template <typename _Tp, typename... _Args,
+		typename _Mgr = _Manager<_Tp>>
+	void __do_emplace(_Args&&... __args)
+	{
+	  reset();
+	  _Mgr::_S_create(_M_storage, std::forward<_Args>(__args)...);
+	  _M_manager = &_Mgr::_S_manage;
+	}
+
+      template <typename _Res, typename _Tp, typename... _Args>
+	using __any_constructible
+	  = std::enable_if<std::__and_<std::bool_constant<_S_storable<_Tp>>,
+				       std::is_copy_constructible<_Tp>,
+				       std::is_constructible<_Tp, _Args...>>::value,
+			   _Res>;
+
+      template <typename _Tp, typename... _Args>
+	using __any_constructible_t
+	  = typename __any_constructible<bool, _Tp, _Args...>::type;
+
+      template<typename _VTp, typename... _Args>
+	using __emplace_t
+	  = typename __any_constructible<_VTp&, _VTp, _Args...>::type;
+
+    public:
+      /// Default constructor, creates an empty object.
+      constexpr basic_any() noexcept : _M_manager(nullptr) { }
+
+      /// Copy constructor, copies the state of @p __other
+      basic_any(const basic_any& __other)
+      {
+	if (!__other.has_value())
+	  _M_manager = nullptr;
+	else
+	  {
+	    _Arg __arg;
+	    __arg._M_any = this;
+	    __other._M_manager(_Op_clone, &__other, &__arg);
+	  }
+      }
+
+      /**
+       * @brief Move constructor, transfer the state from @p __other
+       *
+       * @post @c !__other.has_value()
+       */
+      basic_any(basic_any&& __other) noexcept
+      {
+	if (!__other.has_value())
+	  _M_manager = nullptr;
+	else
+	  {
+	    _Arg __arg;
+	    __arg._M_any = this;
+	    __other._M_manager(_Op_xfer, &__other, &__arg);
+	  }
+      }
+
+      /// Construct with a copy of @p __value as the contained object.
+      template <typename _Tp, typename _VTp = _Decay_if_not_any<_Tp>,
+		typename _Mgr = _Manager<_VTp>,
+		std::enable_if_t<std::is_copy_constructible<_VTp>::value
+				 && !std::__is_in_place_type<_VTp>::value
+				 && _S_storable<_VTp>, bool> = true>
+	basic_any(_Tp&& __value)
+	: _M_manager(&_Mgr::_S_manage)
+	{
+	  _Mgr::_S_create(_M_storage, std::forward<_Tp>(__value));
+	}
+
+      /// Construct with an object created from @p __args as the contained
+      /// object.
+      template <typename _Tp, typename... _Args,
+		typename _VTp = std::decay_t<_Tp>,
+		typename _Mgr = _Manager<_VTp>,
+		__any_constructible_t<_VTp, _Args&&...> = false>
+	explicit
+	basic_any(std::in_place_type_t<_Tp>, _Args&&... __args)
+	: _M_manager(&_Mgr::_S_manage)
+	{
+	  _Mgr::_S_create(_M_storage, std::forward<_Args>(__args)...);
+	}
+
+      /// Construct with an object created from @p __il and @p __args as
+      /// the contained object.
+      template <typename _Tp, typename _Up, typename... _Args,
+		typename _VTp = std::decay_t<_Tp>,
+		typename _Mgr = _Manager<_VTp>,
+		__any_constructible_t<_VTp, std::initializer_list<_Up>,
+				      _Args&&...> = false>
+	explicit
+	basic_any(std::in_place_type_t<_Tp>, std::initializer_list<_Up> __il,
+		  _Args&&... __args)
+	: _M_manager(&_Mgr::_S_manage)
+	{
+	  _Mgr::_S_create(_M_storage, __il, std::forward<_Args>(__args)...);
+	}
+
+      /// Destructor, calls @c reset()
+      ~basic_any() { reset(); }
+
+      /// Copy the state of another object.
+      basic_any&
+      operator=(const basic_any& __rhs)
+      {
+	*this = basic_any(__rhs);
+	return *this;
+      }
+
+      /**
+       * @brief Move assignment operator
+       *
+       * @post @c !__rhs.has_value()
+       */
+      basic_any&
+      operator=(basic_any&& __rhs) noexcept
+      {
+	if (!__rhs.has_value())
+	  reset();
+	else if (this != &__rhs)
+	  {
+	    reset();
+	    _Arg __arg;
+	    __arg._M_any = this;
+	    __rhs._M_manager(_Op_xfer, &__rhs, &__arg);
+	  }
+	return *this;
+      }
+
+      /// Store a copy of @p __rhs as the contained object.
+      template<typename _Tp, typename _VTp = _Decay_if_not_any<_Tp>>
+	std::enable_if_t<std::is_copy_constructible<_VTp>::value
+			 && _S_storable<_VTp>, basic_any&>
+	operator=(_Tp&& __rhs)
+	{
+	  *this = basic_any(std::forward<_Tp>(__rhs));
+	  return *this;
+	}
+
+      /// Emplace with an object created from @p __args as the contained
+      /// object.
+      template <typename _Tp, typename... _Args>
+	__emplace_t<std::decay_t<_Tp>, _Args...>
+	emplace(_Args&&... __args)
+	{
+	  using _VTp = std::decay_t<_Tp>;
+	  __do_emplace<_VTp>(std::forward<_Args>(__args)...);
+	  _Arg __arg;
+	  this->_M_manager(_Op_access, this, &__arg);
+	  return *static_cast<_VTp*>(__arg._M_obj);
+	}
+
+      /// Emplace with an object created from @p __il and @p __args as
+      /// the contained object.
+      template <typename _Tp, typename _Up, typename... _Args>
+	__emplace_t<std::decay_t<_Tp>, std::initializer_list<_Up>, _Args&&...>
+	emplace(std::initializer_list<_Up> __il, _Args&&... __args)
+	{
+	  using _VTp = std::decay_t<_Tp>;
+	  __do_emplace<_VTp>(__il, std::forward<_Args>(__args)...);
+	  _Arg __arg;
+	  this->_M_manager(_Op_access, this, &__arg);
+	  return *static_cast<_VTp*>(__arg._M_obj);
+	}
+
+      /// If not empty, destroy the contained object.
+      void reset() noexcept
+      {
+	if (has_value())
+	{
+	  _M_manager(_Op_destroy, this, nullptr);
+	  _M_manager = nullptr;
+	}
+      }
+
+      /// Exchange state with another object.
+      void swap(basic_any& __rhs) noexcept
+      {
+	if (!has_value() && !__rhs.has_value())
+	  return;
+
+	if (has_value() && __rhs.has_value())
+	  {
+	    if (this == &__rhs)
+	      return;
+
+	    basic_any __tmp;
+	    _Arg __arg;
+	    __arg._M_any = &__tmp;
+	    __rhs._M_manager(_Op_xfer, &__rhs, &__arg);
+	    __arg._M_any = &__rhs;
+	    _M_manager(_Op_xfer, this, &__arg);
+	    __arg._M_any = this;
+	    __tmp._M_manager(_Op_xfer, &__tmp, &__arg);
+	  }
+	else
+	  {
+	    basic_any* __empty = !has_value() ? this : &__rhs;
+	    basic_any* __full = !has_value() ? &__rhs : this;
+	    _Arg __arg;
+	    __arg._M_any = __empty;
+	    __full->_M_manager(_Op_xfer, __full, &__arg);
+	  }
+      }
+
+      /// Reports whether there is a contained object or not.
+      bool has_value() const noexcept { return _M_manager != nullptr; }
+
+#if __cpp_rtti
+      /// The @c typeid of the contained object, or @c typeid(void) if empty.
+      const std::type_info& type() const noexcept
+      {
+	if (!has_value())
+	  return typeid(void);
+	_Arg __arg;
+	_M_manager(_Op_get_type_info, this, &__arg);
+	return *__arg._M_typeinfo;
+      }
+#endif
+
+    private:
+      enum _Op {
+	  _Op_access, _Op_get_type_info, _Op_clone, _Op_destroy, _Op_xfer
+      };
+
+      union _Arg
+      {
+	  void* _M_obj;
+	  const std::type_info* _M_typeinfo;
+	  basic_any* _M_any;
+      };
+
+      void (*_M_manager)(_Op, const basic_any*, _Arg*);
+      _Storage _M_storage;
+
+      template<typename _Tp, typename _Any>
+	friend void* __basic_any_caster(const _Any* __any);
+
+      // Manage in-place contained object.
+      template<typename _Tp>
+	struct _Manager_internal
+	{
+	  static void
+	  _S_manage(_Op __which, const basic_any* __anyp, _Arg* __arg);
+
+	  template<typename... _Args>
+	    static void
+	    _S_create(_Storage& __storage, _Args&&... __args)
+	    {
+	      void* __addr = &__storage._M_buffer;
+	      ::new (__addr) _Tp(std::forward<_Args>(__args)...);
+	    }
+	};
+
+      // Manage external contained object.
+      template<typename _Tp>
+	struct _Manager_external
+	{
+	  static void
+	  _S_manage(_Op __which, const basic_any* __anyp, _Arg* __arg);
+
+	  template<typename... _Args>
+	    static void
+	    _S_create(_Storage& __storage, _Args&&... __args)
+	    {
+	      static_assert(_Allocate, "inplace_any contained object must fit"
+			    " into its buffer, not be over-aligned and be"
+			    " nothrow movable");
+	      __storage._M_ptr = new _Tp(std::forward<_Args>(__args)...);
+	    }
+	};
+    };
+
+  /// Exchange the states of two @c basic_any objects.
+  template<std::size_t _Size, std::size_t _Align, bool _Allocate>
+    inline void
+    swap(basic_any<_Size, _Align, _Allocate>& __x,
+	 basic_any<_Size, _Align, _Allocate>& __y) noexcept
+    { __x.swap(__y); }
+
+  /// @cond undocumented
+  template<typename _Tp, typename _Any>
+    void* __basic_any_caster(const _Any* __any)
+    {
+      using _Up = std::remove_cv_t<_Tp>;
+      if constexpr (!std::is_same_v<std::decay_t<_Up>, _Up>)
+	return nullptr;
+      else if constexpr (!std::is_copy_constructible_v<_Up>)
+	return nullptr;
+      // Nor types that cannot be stored at all:
+      else if constexpr (!_Any::template _S_storable<_Up>)
+	return nullptr;
+      else if (__any->_M_manager
+	       == &_Any::template _Manager<_Up>::_S_manage
+#if __cpp_rtti
+	  || __any->type() == typeid(_Tp)
+#endif
+	  )
+	{
+	  typename _Any::_Arg __arg;
+	  __any->_M_manager(_Any::_Op_access, __any, &__arg);
+	  return __arg._M_obj;
+	}
+      return nullptr;
+    }
+  /// @endcond
+
+  template<std::size_t _Size, std::size_t _Align, bool _Allocate>
+    template<typename _Tp>
+      void
+      basic_any<_Size, _Align, _Allocate>::_Manager_internal<_Tp>::
+      _S_manage(_Op __which, const basic_any* __any, _Arg* __arg)
+      {
+	// The contained object is in _M_storage._M_buffer
+	auto __ptr = reinterpret_cast<const _Tp*>(&__any->_M_storage._M_buffer);
+	switch (__which)
+	{
+	case _Op_access:
+	  __arg->_M_obj = const_cast<_Tp*>(__ptr);
+	  break;
+	case _Op_get_type_info:
+#if __cpp_rtti
+	  __arg->_M_typeinfo = &typeid(_Tp);
+#endif
+	  break;
+	case _Op_clone:
+	  ::new(&__arg->_M_any->_M_storage._M_buffer) _Tp(*__ptr);
+	  __arg->_M_any->_M_manager = __any->_M_manager;
+	  break;
+	case _Op_destroy:
+	  __ptr->~_Tp();
+	  break;
+	case _Op_xfer:
+	  ::new(&__arg->_M_any->_M_storage._M_buffer) _Tp
+	    (std::move(*const_cast<_Tp*>(__ptr)));
+	  __ptr->~_Tp();
+	  __arg->_M_any->_M_manager = __any->_M_manager;
+	  const_cast<basic_any*>(__any)->_M_manager = nullptr;
+	  break;
+	}
+      }
+
+  template<std::size_t _Size, std::size_t _Align, bool _Allocate>
+    template<typename _Tp>
+      void
+      basic_any<_Size, _Align, _Allocate>::_Manager_external<_Tp>::
+      _S_manage(_Op __which, const basic_any* __any, _Arg* __arg)
+      {
+	// The contained object is *_M_storage._M_ptr
+	auto __ptr = static_cast<const _Tp*>(__any->_M_storage._M_ptr);
+	switch (__which)
+	{
+	case _Op_access:
+	  __arg->_M_obj = const_cast<_Tp*>(__ptr);
+	  break;
+	case _Op_get_type_info:
+#if __cpp_rtti
+	  __arg->_M_typeinfo = &typeid(_Tp);
+#endif
+	  break;
+	case _Op_clone:
+	  __arg->_M_any->_M_storage._M_ptr = new _Tp(*__ptr);
+	  __arg->_M_any->_M_manager = __any->_M_manager;
+	  break;
+	case _Op_destroy:
+	  delete __ptr;
+	  break;
+	case _Op_xfer:
+	  __arg->_M_any->_M_storage._M_ptr = __any->_M_storage._M_ptr;
+	  __arg->_M_any->_M_manager = __any->_M_manager;
+	  const_cast<basic_any*>(__any)->_M_manager = nullptr;
+	  break;
+	}
+      }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++17
+
+#endif // _BASIC_ANY_H
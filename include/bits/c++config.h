@@ -582,8 +582,42 @@ namespace std
 // src/functexcept.cc.  We use __N because the more traditional _N is used
 // for something else under certain OSes (see BADNAMES).
 
-// modm avr port: remove exception strings to save RAM
-#define __N(msgid)     ("")
+// modm avr port: remove exception strings to save RAM.  With
+// MODM_FAULT_LOG, each message is replaced by its 16-bit id instead, which
+// src/functexcept.cc records, see <ext/fault_log.h>.
+#if __cplusplus >= 201103L
+namespace __gnu_cxx
+{
+  constexpr unsigned short
+  __fault_fold(unsigned long __h) noexcept
+  { return __h != 0 ? static_cast<unsigned short>(__h) : 1; }
+
+  // FNV-1a over the message, folded to 16 bits; 0 for an empty message.
+  constexpr unsigned short
+  __fault_message_id(const char* __s,
+		     unsigned long __h = 2166136261UL) noexcept
+  {
+    return *__s != '\0'
+      ? __fault_message_id(__s + 1,
+			   ((__h ^ static_cast<unsigned char>(*__s))
+			    * 16777619UL) & 0xffffffffUL)
+      : __h == 2166136261UL ? 0
+      : __fault_fold((__h ^ (__h >> 16)) & 0xffffUL);
+  }
+
+  template<unsigned short _Id>
+    struct __fault_message
+    { static constexpr unsigned short __id = _Id; };
+}
+#endif
+
+#if defined(MODM_FAULT_LOG) && __cplusplus >= 201103L
+# define __N(msgid) \
+  (reinterpret_cast<const char*>(static_cast<__UINTPTR_TYPE__>( \
+     __gnu_cxx::__fault_message<__gnu_cxx::__fault_message_id(msgid)>::__id)))
+#else
+# define __N(msgid)     ("")
+#endif
 
 // For example, <windows.h> is known to #define min and max as macros...
 #undef min
@@ -0,0 +1,209 @@
+// Implementation of std::function_ref -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file include/bits/funcref_impl.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{functional}
+ *
+ *  Included by bits/function_ref.h once for each cv-qualification of
+ *  the signature, given by _GLIBCXX_FUNCREF_CV.
+ */
+
+#ifndef _GLIBCXX_FUNCREF_CV
+# error "bits/funcref_impl.h is an internal header and must not be used directly"
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief Non-owning reference to a callable.
+   *  @ingroup functors
+   *
+   *  A function_ref holds the address of its target and a pointer to a
+   *  function calling it, two pointers in all.  It is trivially copyable,
+   *  never allocates, and must not outlive the target it refers to.
+   */
+  template<typename _Res, typename... _ArgTypes, bool _Noex>
+    class function_ref<_Res(_ArgTypes...) _GLIBCXX_FUNCREF_CV
+		       noexcept(_Noex)>
+    {
+      template<typename... _Tps>
+	static constexpr bool __is_invocable_using
+	  = conditional_t<_Noex,
+			  is_nothrow_invocable_r<_Res, _Tps..., _ArgTypes...>,
+			  is_invocable_r<_Res, _Tps..., _ArgTypes...>>::value;
+
+      template<typename _Tp>
+	using __cv_t = _Tp _GLIBCXX_FUNCREF_CV;
+
+      using _Invoker = _Res (*)(_Funcref_storage,
+				__polyfunc_param_t<_ArgTypes>...) noexcept(_Noex);
+
+      // Call a function through its address.
+      template<typename _Fn>
+	static _Res
+	_S_fn(_Funcref_storage __s,
+	      __polyfunc_param_t<_ArgTypes>... __args) noexcept(_Noex)
+	{
+	  return std::__invoke_r<_Res>(reinterpret_cast<_Fn*>(__s._M_fn),
+				       std::forward<_ArgTypes>(__args)...);
+	}
+
+      // Call an object, which may be const, through its address.
+      template<typename _Tp>
+	static _Res
+	_S_obj(_Funcref_storage __s,
+	       __polyfunc_param_t<_ArgTypes>... __args) noexcept(_Noex)
+	{
+	  _Tp* __obj = static_cast<_Tp*>(const_cast<void*>(__s._M_obj));
+	  return std::__invoke_r<_Res>(static_cast<__cv_t<_Tp>&>(*__obj),
+				       std::forward<_ArgTypes>(__args)...);
+	}
+
+      template<auto _Fn>
+	static _Res
+	_S_nttp(_Funcref_storage,
+		__polyfunc_param_t<_ArgTypes>... __args) noexcept(_Noex)
+	{
+	  return std::__invoke_r<_Res>(_Fn,
+				       std::forward<_ArgTypes>(__args)...);
+	}
+
+      // Call _Fn with the bound object as first argument.
+      template<auto _Fn, typename _Tp>
+	static _Res
+	_S_bound_ref(_Funcref_storage __s,
+		     __polyfunc_param_t<_ArgTypes>... __args) noexcept(_Noex)
+	{
+	  _Tp* __obj = static_cast<_Tp*>(const_cast<void*>(__s._M_obj));
+	  return std::__invoke_r<_Res>(_Fn, static_cast<__cv_t<_Tp>&>(*__obj),
+				       std::forward<_ArgTypes>(__args)...);
+	}
+
+      template<auto _Fn, typename _Tp>
+	static _Res
+	_S_bound_ptr(_Funcref_storage __s,
+		     __polyfunc_param_t<_ArgTypes>... __args) noexcept(_Noex)
+	{
+	  _Tp* __obj = static_cast<_Tp*>(const_cast<void*>(__s._M_obj));
+	  return std::__invoke_r<_Res>(_Fn, static_cast<__cv_t<_Tp>*>(__obj),
+				       std::forward<_ArgTypes>(__args)...);
+	}
+
+      template<auto _Fn>
+	static constexpr bool __is_null()
+	{
+	  if constexpr (is_pointer_v<decltype(_Fn)>)
+	    return _Fn == nullptr;
+	  else
+	    return false;
+	}
+
+    public:
+      /// Refer to a function, which must not be null.
+      template<typename _Fn,
+	       typename = enable_if_t<is_function_v<_Fn>
+				      && __is_invocable_using<_Fn>>>
+	function_ref(_Fn* __f) noexcept
+	: _M_bound(), _M_invoker(&_S_fn<_Fn>)
+	{
+	  __glibcxx_assert(__f != nullptr);
+	  _M_bound._M_fn = reinterpret_cast<void (*)()>(__f);
+	}
+
+      /// Refer to a callable object, which must outlive the function_ref.
+      template<typename _Fn, typename _Tp = remove_reference_t<_Fn>,
+	       typename = enable_if_t<!is_same_v<remove_cv_t<_Tp>, function_ref>
+				      && !is_function_v<_Tp>
+				      && !is_member_pointer_v<_Tp>
+				      && __is_invocable_using<__cv_t<_Tp>&>>>
+	constexpr
+	function_ref(_Fn&& __f) noexcept
+	: _M_bound{ std::__addressof(__f) }, _M_invoker(&_S_obj<_Tp>)
+	{ }
+
+      /// Refer to a callable given as a template argument.
+      template<auto _Fn,
+	       typename = enable_if_t<__is_invocable_using<
+					const decltype(_Fn)&>>>
+	constexpr
+	function_ref(nontype_t<_Fn>) noexcept
+	: _M_bound(), _M_invoker(&_S_nttp<_Fn>)
+	{ static_assert(!__is_null<_Fn>(), "function_ref target must not be null"); }
+
+      /// Refer to _Fn bound to an object passed as its first argument.
+      template<auto _Fn, typename _Up, typename _Tp = remove_reference_t<_Up>,
+	       typename = enable_if_t<!is_rvalue_reference_v<_Up&&>
+				      && __is_invocable_using<
+					   const decltype(_Fn)&,
+					   __cv_t<_Tp>&>>>
+	constexpr
+	function_ref(nontype_t<_Fn>, _Up&& __obj) noexcept
+	: _M_bound{ std::__addressof(__obj) },
+	  _M_invoker(&_S_bound_ref<_Fn, _Tp>)
+	{ static_assert(!__is_null<_Fn>(), "function_ref target must not be null"); }
+
+      /// Refer to _Fn bound to a pointer passed as its first argument.
+      template<auto _Fn, typename _Tp,
+	       typename = enable_if_t<__is_invocable_using<
+					const decltype(_Fn)&,
+					__cv_t<_Tp>*>>>
+	constexpr
+	function_ref(nontype_t<_Fn>, __cv_t<_Tp>* __obj) noexcept
+	: _M_bound{ __obj }, _M_invoker(&_S_bound_ptr<_Fn, _Tp>)
+	{
+	  static_assert(!__is_null<_Fn>(), "function_ref target must not be null");
+	  if constexpr (is_member_pointer_v<decltype(_Fn)>)
+	    __glibcxx_assert(__obj != nullptr);
+	}
+
+      constexpr function_ref(const function_ref&) noexcept = default;
+
+      constexpr function_ref&
+      operator=(const function_ref&) noexcept = default;
+
+      // Rebinding to a temporary would leave the reference dangling.
+      template<typename _Tp,
+	       typename = enable_if_t<!is_same_v<_Tp, function_ref>
+				      && !is_pointer_v<_Tp>
+				      && !__is_nontype<_Tp>::value>>
+	function_ref&
+	operator=(_Tp) = delete;
+
+      /// Invoke the target.
+      _Res
+      operator()(_ArgTypes... __args) const noexcept(_Noex)
+      { return _M_invoker(_M_bound, std::forward<_ArgTypes>(__args)...); }
+
+    private:
+      _Funcref_storage _M_bound;
+      _Invoker _M_invoker;
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#undef _GLIBCXX_FUNCREF_CV
@@ -60,36 +60,44 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   __throw_bad_typeid(void) __attribute__((__noreturn__));
 
   // Helpers for exception objects in <stdexcept>
+  //
+  // These are weak in src/functexcept.cc and may be replaced by the
+  // application.  Pass every message through __N().  With MODM_FAULT_LOG
+  // defined, __N() yields the 16-bit id of the message cast to a pointer,
+  // not text, so a replacement must not dereference __s; it recovers the
+  // id as static_cast<unsigned short>(reinterpret_cast<__UINTPTR_TYPE__>
+  // (__s)) and compares it with __gnu_cxx::fault_log::message_id("...").
+  // Without MODM_FAULT_LOG, __s is the text of the message.
   void
-  __throw_logic_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_logic_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_domain_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_domain_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_invalid_argument(const char* __s = "") __attribute__((__noreturn__));
+  __throw_invalid_argument(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_length_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_length_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_out_of_range(const char* __s = "") __attribute__((__noreturn__));
+  __throw_out_of_range(const char* __s = __N("")) __attribute__((__noreturn__));
 
   inline void __attribute__((__noreturn__)) __attribute__((always_inline))
-  __throw_out_of_range_fmt(const char*, ...)
-  { __throw_out_of_range(); }
+  __throw_out_of_range_fmt(const char* __s, ...)
+  { __throw_out_of_range(__s); }
 
   void
-  __throw_runtime_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_runtime_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_range_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_range_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_overflow_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_overflow_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
-  __throw_underflow_error(const char* __s = "") __attribute__((__noreturn__));
+  __throw_underflow_error(const char* __s = __N("")) __attribute__((__noreturn__));
 
   // Helpers for exception objects in <system_error>
   void
@@ -103,11 +111,19 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   __throw_bad_optional_access() __attribute__((__noreturn__));
 
   void
-  __throw_bad_variant_access(const char* __s = "") __attribute__((__noreturn__));
+  __throw_bad_variant_access(const char* __s = __N("")) __attribute__((__noreturn__));
 
   void
   __throw_bad_any_cast() __attribute__((__noreturn__));
 
+  // Helpers for exception objects in <expected>
+  void
+  __throw_bad_expected_access() __attribute__((__noreturn__));
+
+  // Helpers for exception objects in <memory>
+  void
+  __throw_bad_weak_ptr() __attribute__((__noreturn__));
+
 _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace
 
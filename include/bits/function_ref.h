@@ -0,0 +1,132 @@
+// Implementation of std::function_ref -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file include/bits/function_ref.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{functional}
+ */
+
+#ifndef _GLIBCXX_FUNCTION_REF_H
+#define _GLIBCXX_FUNCTION_REF_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <bits/invoke.h>
+#include <bits/move.h>
+#include <type_traits>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+#if __cplusplus > 202302L
+# define __cpp_lib_function_ref 202306L
+#endif
+
+  /// A callable given as a template argument, for std::function_ref.
+  template<auto _Fn>
+    struct nontype_t
+    {
+      explicit nontype_t() = default;
+    };
+
+  template<auto _Fn>
+    inline constexpr nontype_t<_Fn> nontype{};
+
+  template<typename _Signature>
+    class function_ref;
+
+  template<typename _Tp>
+    struct __is_nontype
+    : false_type
+    { };
+
+  template<auto _Fn>
+    struct __is_nontype<nontype_t<_Fn>>
+    : true_type
+    { };
+
+  // Arguments that fit into registers are passed by value to the function
+  // that calls the target, so they need not be stored to memory first.
+  template<typename _Tp, typename = void>
+    struct __polyfunc_param
+    { using type = _Tp&&; };
+
+  template<typename _Tp>
+    struct __polyfunc_param<_Tp, enable_if_t<is_object_v<_Tp>
+					      && is_trivially_copyable_v<_Tp>
+					      && sizeof(_Tp) <= 2 * sizeof(void*)>>
+    { using type = _Tp; };
+
+  template<typename _Tp>
+    using __polyfunc_param_t = typename __polyfunc_param<_Tp>::type;
+
+  // The entity a function_ref is bound to: the address of an object or a
+  // function.  Nothing is stored for a callable given by nontype.
+  union _Funcref_storage
+  {
+    const void* _M_obj;
+    void (*_M_fn)();
+  };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#define _GLIBCXX_FUNCREF_CV
+#include "funcref_impl.h"
+#define _GLIBCXX_FUNCREF_CV const
+#include "funcref_impl.h"
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template<typename _Res, typename... _ArgTypes>
+    function_ref(_Res(*)(_ArgTypes...)) -> function_ref<_Res(_ArgTypes...)>;
+
+  template<typename _Res, typename... _ArgTypes>
+    function_ref(_Res(*)(_ArgTypes...) noexcept)
+    -> function_ref<_Res(_ArgTypes...) noexcept>;
+
+  template<typename _Fn>
+    struct __funcref_nontype_guide
+    { };
+
+  template<typename _Res, typename... _ArgTypes, bool _Noex>
+    struct __funcref_nontype_guide<_Res(*)(_ArgTypes...) noexcept(_Noex)>
+    { using type = _Res(_ArgTypes...) noexcept(_Noex); };
+
+  template<auto _Fn>
+    function_ref(nontype_t<_Fn>)
+    -> function_ref<typename __funcref_nontype_guide<
+	 decay_t<decltype(_Fn)>>::type>;
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _GLIBCXX_FUNCTION_REF_H
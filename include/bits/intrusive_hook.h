@@ -0,0 +1,64 @@
+// Access to the object owning a hook of an intrusive container -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/intrusive_hook.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/ilist.h}
+ */
+
+#ifndef _INTRUSIVE_HOOK_H
+#define _INTRUSIVE_HOOK_H 1
+
+#pragma GCC system_header
+
+#include <bits/c++config.h>
+#include <cstddef>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // Return the object of which *__h is the member __m.  Under the Itanium
+  // C++ ABI, used by GCC on all targets, a pointer to data member holds the
+  // offset of the member, so this is a single subtraction.
+  template<typename _Tp, typename _Hook>
+    inline _Tp*
+    __hook_owner(_Hook* __h, _Hook _Tp::* __m) noexcept
+    {
+      static_assert(sizeof(__m) == sizeof(std::ptrdiff_t),
+		    "pointer to data member must hold an offset");
+      std::ptrdiff_t __off;
+      __builtin_memcpy(&__off, &__m, sizeof(__off));
+      return reinterpret_cast<_Tp*>(reinterpret_cast<char*>(__h) - __off);
+    }
+
+  template<typename _Tp, typename _Hook>
+    inline const _Tp*
+    __hook_owner(const _Hook* __h, _Hook _Tp::* __m) noexcept
+    { return __gnu_cxx::__hook_owner(const_cast<_Hook*>(__h), __m); }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // _INTRUSIVE_HOOK_H
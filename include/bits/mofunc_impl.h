@@ -0,0 +1,281 @@
+// Implementation of std::move_only_function -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file include/bits/mofunc_impl.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{functional}
+ *
+ *  Included by bits/move_only_function.h once for each cv- and
+ *  ref-qualification of the signature, given by _GLIBCXX_MOF_CV and
+ *  _GLIBCXX_MOF_REF.
+ */
+
+#ifndef _GLIBCXX_MOF_CV
+# define _GLIBCXX_MOF_CV
+#endif
+
+#ifdef _GLIBCXX_MOF_REF
+# define _GLIBCXX_MOF_INV_QUALS _GLIBCXX_MOF_CV _GLIBCXX_MOF_REF
+#else
+# define _GLIBCXX_MOF_REF
+# define _GLIBCXX_MOF_INV_QUALS _GLIBCXX_MOF_CV &
+#endif
+
+#define _GLIBCXX_MOF_CV_REF _GLIBCXX_MOF_CV _GLIBCXX_MOF_REF
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief Polymorphic function wrapper for callables that cannot be
+   *  copied.
+   *  @ingroup functors
+   *
+   *  Targets of up to MODM_MOVE_ONLY_FUNCTION_CAPACITY bytes whose move
+   *  constructor does not throw are stored in place; larger ones are
+   *  allocated.  Besides the buffer, a wrapper holds a single pointer to
+   *  a table with the functions calling, moving and destroying its
+   *  target.  Calling an empty wrapper reports bad_function_call.
+   */
+  template<typename _Res, typename... _ArgTypes, bool _Noex>
+    class move_only_function<_Res(_ArgTypes...) _GLIBCXX_MOF_CV
+			     _GLIBCXX_MOF_REF noexcept(_Noex)>
+    : _Mofunc_base
+    {
+      template<typename _Tp>
+	using __callable
+	  = conditional_t<_Noex,
+			  is_nothrow_invocable_r<_Res, _Tp, _ArgTypes...>,
+			  is_invocable_r<_Res, _Tp, _ArgTypes...>>;
+
+      // [func.wrap.move.ctor]
+      template<typename _Vt>
+	static constexpr bool __is_callable_from
+	  = __and_v<__callable<_Vt _GLIBCXX_MOF_CV_REF>,
+		    __callable<_Vt _GLIBCXX_MOF_INV_QUALS>>;
+
+      using _Invoker = _Res (*)(const _Storage&,
+				__polyfunc_param_t<_ArgTypes>...) noexcept(_Noex);
+
+      struct _Vtable : _Vtable_base
+      {
+	_Invoker _M_invoke;
+      };
+
+      template<typename _Tp>
+	static _Res
+	_S_invoke(const _Storage& __s,
+		  __polyfunc_param_t<_ArgTypes>... __args) noexcept(_Noex)
+	{
+	  using _TpInv = _Tp _GLIBCXX_MOF_INV_QUALS;
+	  return std::__invoke_r<_Res>(
+	      std::forward<_TpInv>(*_S_access<_Tp>(__s)),
+	      std::forward<_ArgTypes>(__args)...);
+	}
+
+      static _Res
+      _S_invoke_empty(const _Storage&,
+		      __polyfunc_param_t<_ArgTypes>...) noexcept(_Noex)
+      { std::__throw_bad_function_call(); }
+
+      template<typename _Tp>
+	static constexpr _Vtable _S_vtable
+	  = { { _S_manager<_Tp>() }, &_S_invoke<_Tp> };
+
+      static constexpr _Vtable _S_empty_vtable
+	= { { &_S_empty }, &_S_invoke_empty };
+
+      template<typename _Tp>
+	static bool
+	_S_not_empty(const _Tp& __f) noexcept
+	{
+	  if constexpr (is_function_v<remove_pointer_t<_Tp>>
+			|| is_member_pointer_v<_Tp>
+			|| __is_move_only_function<_Tp>::value)
+	    return __f != nullptr;
+	  else
+	    return true;
+	}
+
+      template<typename _Tp, typename... _Args>
+	void
+	_M_init(_Args&&... __args)
+	noexcept(noexcept(_S_init<_Tp>(_M_storage,
+				       std::forward<_Args>(__args)...)))
+	{
+	  _S_init<_Tp>(_M_storage, std::forward<_Args>(__args)...);
+	  _M_vt = &_S_vtable<_Tp>;
+	}
+
+      template<typename>
+	friend class move_only_function;
+
+    public:
+      using result_type = _Res;
+
+      move_only_function() noexcept
+      : _Mofunc_base(&_S_empty_vtable)
+      { }
+
+      move_only_function(nullptr_t) noexcept
+      : _Mofunc_base(&_S_empty_vtable)
+      { }
+
+      /// The target of @a __x is moved, and @a __x is left empty.
+      move_only_function(move_only_function&& __x) noexcept
+      : _Mofunc_base(&_S_empty_vtable)
+      { _M_take(__x, &_S_empty_vtable); }
+
+      /**
+       *  @brief Builds a wrapper targeting @a __f, moved or copied.
+       *
+       *  If @a __f is a null function pointer, a null pointer to member
+       *  or an empty move_only_function, the new wrapper is empty.
+       */
+      template<typename _Fn, typename _Vt = decay_t<_Fn>,
+	       typename = enable_if_t<!is_same_v<_Vt, move_only_function>
+				      && !__is_in_place_type<_Vt>::value
+				      && __is_callable_from<_Vt>>>
+	move_only_function(_Fn&& __f)
+	noexcept(noexcept(_S_init<_Vt>(std::declval<_Storage&>(),
+				       std::forward<_Fn>(__f))))
+	: _Mofunc_base(&_S_empty_vtable)
+	{
+	  static_assert(is_constructible_v<_Vt, _Fn>);
+	  if (_S_not_empty(__f))
+	    _M_init<_Vt>(std::forward<_Fn>(__f));
+	}
+
+      /// Builds a wrapper targeting a _Tp made from @a __args.
+      template<typename _Tp, typename... _Args,
+	       typename = enable_if_t<is_constructible_v<_Tp, _Args...>
+				      && __is_callable_from<_Tp>>>
+	explicit
+	move_only_function(in_place_type_t<_Tp>, _Args&&... __args)
+	noexcept(noexcept(_S_init<_Tp>(std::declval<_Storage&>(),
+				       std::forward<_Args>(__args)...)))
+	: _Mofunc_base(&_S_empty_vtable)
+	{
+	  static_assert(is_same_v<decay_t<_Tp>, _Tp>);
+	  _M_init<_Tp>(std::forward<_Args>(__args)...);
+	}
+
+      /// @overload
+      template<typename _Tp, typename _Up, typename... _Args,
+	       typename = enable_if_t<is_constructible_v<_Tp,
+							 initializer_list<_Up>&,
+							 _Args...>
+				      && __is_callable_from<_Tp>>>
+	explicit
+	move_only_function(in_place_type_t<_Tp>, initializer_list<_Up> __il,
+			   _Args&&... __args)
+	noexcept(noexcept(_S_init<_Tp>(std::declval<_Storage&>(), __il,
+				       std::forward<_Args>(__args)...)))
+	: _Mofunc_base(&_S_empty_vtable)
+	{
+	  static_assert(is_same_v<decay_t<_Tp>, _Tp>);
+	  _M_init<_Tp>(__il, std::forward<_Args>(__args)...);
+	}
+
+      move_only_function(const move_only_function&) = delete;
+
+      move_only_function&
+      operator=(const move_only_function&) = delete;
+
+      move_only_function&
+      operator=(move_only_function&& __x) noexcept
+      {
+	if (this != &__x)
+	  {
+	    _M_reset(&_S_empty_vtable);
+	    _M_take(__x, &_S_empty_vtable);
+	  }
+	return *this;
+      }
+
+      move_only_function&
+      operator=(nullptr_t) noexcept
+      {
+	_M_reset(&_S_empty_vtable);
+	return *this;
+      }
+
+      template<typename _Fn>
+	enable_if_t<is_constructible_v<move_only_function, _Fn>,
+		    move_only_function&>
+	operator=(_Fn&& __f)
+	noexcept(is_nothrow_constructible_v<move_only_function, _Fn>)
+	{
+	  *this = move_only_function(std::forward<_Fn>(__f));
+	  return *this;
+	}
+
+      /// Determine if the wrapper has a target.
+      explicit operator bool() const noexcept
+      { return _M_vt != &_S_empty_vtable; }
+
+      /// Invokes the target.
+      _Res
+      operator()(_ArgTypes... __args) _GLIBCXX_MOF_CV_REF noexcept(_Noex)
+      {
+	return static_cast<const _Vtable*>(_M_vt)->_M_invoke(
+	    _M_storage, std::forward<_ArgTypes>(__args)...);
+      }
+
+      /// Swap the targets of two wrappers.
+      void
+      swap(move_only_function& __x) noexcept
+      { _M_swap(__x); }
+
+      friend void
+      swap(move_only_function& __x, move_only_function& __y) noexcept
+      { __x.swap(__y); }
+
+      friend bool
+      operator==(const move_only_function& __x, nullptr_t) noexcept
+      { return !__x; }
+
+#if __cpp_impl_three_way_comparison < 201907L
+      friend bool
+      operator==(nullptr_t, const move_only_function& __x) noexcept
+      { return !__x; }
+
+      friend bool
+      operator!=(const move_only_function& __x, nullptr_t) noexcept
+      { return static_cast<bool>(__x); }
+
+      friend bool
+      operator!=(nullptr_t, const move_only_function& __x) noexcept
+      { return static_cast<bool>(__x); }
+#endif
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#undef _GLIBCXX_MOF_CV_REF
+#undef _GLIBCXX_MOF_CV
+#undef _GLIBCXX_MOF_REF
+#undef _GLIBCXX_MOF_INV_QUALS
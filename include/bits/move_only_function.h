@@ -0,0 +1,224 @@
+// Implementation of std::move_only_function -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file include/bits/move_only_function.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{functional}
+ */
+
+#ifndef _GLIBCXX_MOVE_ONLY_FUNCTION_H
+#define _GLIBCXX_MOVE_ONLY_FUNCTION_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <bits/function_ref.h>
+#include <bits/functexcept.h>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+// Bytes a move_only_function stores its target in before it allocates.
+#if !defined(MODM_MOVE_ONLY_FUNCTION_CAPACITY)
+#define MODM_MOVE_ONLY_FUNCTION_CAPACITY (3 * sizeof(void*))
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+#if __cplusplus > 202002L
+# define __cpp_lib_move_only_function 202110L
+#endif
+
+  template<typename _Signature>
+    class move_only_function;
+
+  template<typename _Tp>
+    struct __is_move_only_function
+    : false_type
+    { };
+
+  template<typename _Signature>
+    struct __is_move_only_function<move_only_function<_Signature>>
+    : true_type
+    { };
+
+  /// Storage and ownership of the target, common to all signatures.
+  class _Mofunc_base
+  {
+  protected:
+    union _Storage
+    {
+      void*       _M_p;
+      void (*_M_fp)();
+      unsigned char _M_bytes[MODM_MOVE_ONLY_FUNCTION_CAPACITY];
+    };
+
+    using _Manager = void (*)(_Storage*, _Storage*) noexcept;
+
+    // The first part of the table of a target type; the signature adds
+    // the function calling the target.  With a destination, _M_manage
+    // moves the target there and destroys the source, otherwise it only
+    // destroys the source.
+    struct _Vtable_base
+    {
+      _Manager _M_manage;
+    };
+
+    // Targets are only stored in place when moving them cannot throw,
+    // so that a move_only_function can be moved without throwing.
+    template<typename _Tp>
+      static constexpr bool __stored_locally
+	= sizeof(_Tp) <= sizeof(_Storage)
+	  && alignof(_Storage) % alignof(_Tp) == 0
+	  && is_nothrow_move_constructible_v<_Tp>;
+
+    template<typename _Tp>
+      static _Tp*
+      _S_access(const _Storage& __s) noexcept
+      {
+	if constexpr (__stored_locally<_Tp>)
+	  return static_cast<_Tp*>(const_cast<void*>(
+		   static_cast<const void*>(__s._M_bytes)));
+	else
+	  return static_cast<_Tp*>(__s._M_p);
+      }
+
+    template<typename _Tp, typename... _Args>
+      static void
+      _S_init(_Storage& __s, _Args&&... __args)
+      noexcept(__stored_locally<_Tp>
+	       && is_nothrow_constructible_v<_Tp, _Args...>)
+      {
+	if constexpr (__stored_locally<_Tp>)
+	  ::new (__s._M_bytes) _Tp(std::forward<_Args>(__args)...);
+	else
+	  __s._M_p = new _Tp(std::forward<_Args>(__args)...);
+      }
+
+    template<typename _Tp>
+      static void
+      _S_manage(_Storage* __dest, _Storage* __source) noexcept
+      {
+	if constexpr (__stored_locally<_Tp>)
+	  {
+	    _Tp* __f = _S_access<_Tp>(*__source);
+	    if (__dest)
+	      ::new (__dest->_M_bytes) _Tp(std::move(*__f));
+	    __f->~_Tp();
+	  }
+	else if (__dest)
+	  __dest->_M_p = __source->_M_p;
+	else
+	  delete static_cast<_Tp*>(__source->_M_p);
+      }
+
+    // Trivially copyable targets stored in place are moved by copying
+    // their bytes, and all of the same size share this function.
+    template<size_t _Size>
+      static void
+      _S_manage_bytes(_Storage* __dest, _Storage* __source) noexcept
+      {
+	if (__dest)
+	  __builtin_memcpy(__dest->_M_bytes, __source->_M_bytes, _Size);
+      }
+
+    template<typename _Tp>
+      static constexpr _Manager
+      _S_manager() noexcept
+      {
+	if constexpr (__stored_locally<_Tp> && is_trivially_copyable_v<_Tp>)
+	  return &_S_manage_bytes<sizeof(_Tp)>;
+	else
+	  return &_S_manage<_Tp>;
+      }
+
+    static void
+    _S_empty(_Storage*, _Storage*) noexcept
+    { }
+
+    _Mofunc_base(const _Vtable_base* __vt) noexcept
+    : _M_vt(__vt)
+    { }
+
+    ~_Mofunc_base()
+    { _M_vt->_M_manage(nullptr, &_M_storage); }
+
+    // Take the target of __x, which is left with the table __empty.
+    void
+    _M_take(_Mofunc_base& __x, const _Vtable_base* __empty) noexcept
+    {
+      _M_vt = __x._M_vt;
+      _M_vt->_M_manage(&_M_storage, &__x._M_storage);
+      __x._M_vt = __empty;
+    }
+
+    void
+    _M_reset(const _Vtable_base* __empty) noexcept
+    {
+      _M_vt->_M_manage(nullptr, &_M_storage);
+      _M_vt = __empty;
+    }
+
+    void
+    _M_swap(_Mofunc_base& __x) noexcept
+    {
+      if (this == &__x)
+	return;
+      _Storage __tmp;
+      __x._M_vt->_M_manage(&__tmp, &__x._M_storage);
+      _M_vt->_M_manage(&__x._M_storage, &_M_storage);
+      __x._M_vt->_M_manage(&_M_storage, &__tmp);
+      std::swap(_M_vt, __x._M_vt);
+    }
+
+    const _Vtable_base* _M_vt;
+    _Storage _M_storage;
+  };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#define _GLIBCXX_MOF_CV
+#include "mofunc_impl.h"
+#define _GLIBCXX_MOF_CV
+#define _GLIBCXX_MOF_REF &
+#include "mofunc_impl.h"
+#define _GLIBCXX_MOF_CV
+#define _GLIBCXX_MOF_REF &&
+#include "mofunc_impl.h"
+#define _GLIBCXX_MOF_CV const
+#include "mofunc_impl.h"
+#define _GLIBCXX_MOF_CV const
+#define _GLIBCXX_MOF_REF &
+#include "mofunc_impl.h"
+#define _GLIBCXX_MOF_CV const
+#define _GLIBCXX_MOF_REF &&
+#include "mofunc_impl.h"
+
+#endif // C++17
+
+#endif // _GLIBCXX_MOVE_ONLY_FUNCTION_H
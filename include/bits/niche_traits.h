@@ -0,0 +1,83 @@
+// Spare values of a type for compact wrappers -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/niche_traits.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{expected}
+ */
+
+#ifndef _NICHE_TRAITS_H
+#define _NICHE_TRAITS_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <type_traits>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief Names a value that objects of type @a _Tp never hold.
+   *
+   *  A wrapper that needs one more state than @a _Tp has, such as
+   *  std::expected<void, _Tp> or __gnu_cxx::compact_optional<_Tp>, stores
+   *  that state as this value instead of in a separate flag.  Specialize
+   *  it for a trivially copyable, equality comparable type with a spare
+   *  value:
+   *
+   *  @code
+   *  enum class error : std::uint8_t { timeout = 1, checksum, overrun };
+   *
+   *  template<>
+   *    struct __gnu_cxx::niche_traits<error>
+   *    { static constexpr error niche = error(0); };
+   *  @endcode
+   */
+  template<typename _Tp>
+    struct niche_traits
+    { };
+
+  template<typename _Tp, typename = void>
+    inline constexpr bool __has_niche = false;
+
+  template<typename _Tp>
+    inline constexpr bool __has_niche<_Tp,
+      std::void_t<decltype(niche_traits<_Tp>::niche)>>
+      = std::is_trivially_copyable_v<_Tp>;
+
+  // True if __x is the niche of its type.
+  template<typename _Tp>
+    constexpr bool
+    __is_niche(const _Tp& __x) noexcept
+    { return static_cast<bool>(__x == niche_traits<_Tp>::niche); }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++17
+
+#endif // _NICHE_TRAITS_H
@@ -966,7 +966,7 @@ namespace ranges
 	}
       else
 	{
-#ifdef __cpp_lib_is_constant_evaluated
+#if __cpp_lib_is_constant_evaluated && __cpp_exceptions
 	  if (std::is_constant_evaluated() && __n < 0)
 	    throw "attempt to decrement a non-bidirectional iterator";
 #endif
@@ -998,7 +998,7 @@ namespace ranges
       if constexpr (sized_sentinel_for<_Sent, _It>)
 	{
 	  const auto __diff = __bound - __it;
-#ifdef __cpp_lib_is_constant_evaluated
+#if __cpp_lib_is_constant_evaluated && __cpp_exceptions
 	  if (std::is_constant_evaluated()
 	      && !(__n == 0 || __diff == 0 || (__n < 0 == __diff < 0)))
 	    throw "inconsistent directions for distance and bound";
@@ -1044,7 +1044,7 @@ namespace ranges
 	}
       else
 	{
-#ifdef __cpp_lib_is_constant_evaluated
+#if __cpp_lib_is_constant_evaluated && __cpp_exceptions
 	  if (std::is_constant_evaluated() && __n < 0)
 	    throw "attempt to decrement a non-bidirectional iterator";
 #endif
@@ -34,6 +34,7 @@
 
 #include <bits/ranges_algobase.h>
 #include <bits/uniform_int_dist.h> // concept uniform_random_bit_generator
+#include <optional> // ranges::fold_left_first
 
 #if __cpp_lib_concepts
 namespace std _GLIBCXX_VISIBILITY(default)
@@ -65,6 +66,16 @@ namespace ranges
 			       std::__invoke(__proj, std::forward<_Tp>(__arg)));
 	};
       }
+
+    // find on a contiguous range of bytes compared with an integer or the
+    // byte type itself, which memchr can do.
+    template<typename _Iter, typename _Sent, typename _Tp, typename _Proj>
+      concept __memchr_searchable = contiguous_iterator<_Iter>
+	&& sized_sentinel_for<_Sent, _Iter>
+	&& same_as<_Proj, identity>
+	&& bool(__is_byte<iter_value_t<_Iter>>::__value)
+	&& !is_volatile_v<remove_reference_t<iter_reference_t<_Iter>>>
+	&& (is_integral_v<_Tp> || same_as<_Tp, iter_value_t<_Iter>>);
   } // namespace __detail
 
   struct __all_of_fn
@@ -243,6 +254,27 @@ namespace ranges
       operator()(_Iter __first, _Sent __last,
 		 const _Tp& __value, _Proj __proj = {}) const
       {
+	if constexpr (__detail::__memchr_searchable<_Iter, _Sent, _Tp, _Proj>)
+#ifdef __cpp_lib_is_constant_evaluated
+	  if (!std::is_constant_evaluated())
+#endif
+	    {
+	      using _ValueType = iter_value_t<_Iter>;
+	      auto __n = __last - __first;
+	      // A value that the element type cannot represent compares
+	      // unequal to every element.
+	      if constexpr (is_integral_v<_Tp>)
+		if (!(static_cast<_ValueType>(__value) == __value))
+		  return __first + __n;
+	      if (__n <= 0)
+		return __first;
+	      auto __p = std::to_address(__first);
+	      auto __q = static_cast<decltype(__p)>(__builtin_memchr(__p,
+		  static_cast<unsigned char>(static_cast<_ValueType>(__value)),
+		  static_cast<size_t>(__n)));
+	      return __first + (__q ? __q - __p : __n);
+	    }
+
 	while (__first != __last
 	    && !(std::__invoke(__proj, *__first) == __value))
 	  ++__first;
@@ -3690,9 +3722,658 @@ namespace ranges
 
   inline constexpr __prev_permutation_fn prev_permutation{};
 
+  // The algorithms below are C++23 additions, provided here in C++20 mode too.
+
+  struct __contains_fn
+  {
+    template<input_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     typename _Tp, typename _Proj = identity>
+      requires indirect_binary_predicate<ranges::equal_to,
+					 projected<_Iter, _Proj>, const _Tp*>
+      constexpr bool
+      operator()(_Iter __first, _Sent __last,
+		 const _Tp& __value, _Proj __proj = {}) const
+      {
+	return ranges::find(std::move(__first), __last,
+			    __value, std::move(__proj)) != __last;
+      }
+
+    template<input_range _Range, typename _Tp, typename _Proj = identity>
+      requires indirect_binary_predicate<ranges::equal_to,
+					 projected<iterator_t<_Range>, _Proj>,
+					 const _Tp*>
+      constexpr bool
+      operator()(_Range&& __r, const _Tp& __value, _Proj __proj = {}) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r),
+		       __value, std::move(__proj));
+      }
+  };
+
+  inline constexpr __contains_fn contains{};
+
+  struct __contains_subrange_fn
+  {
+    template<forward_iterator _Iter1, sentinel_for<_Iter1> _Sent1,
+	     forward_iterator _Iter2, sentinel_for<_Iter2> _Sent2,
+	     typename _Pred = ranges::equal_to,
+	     typename _Proj1 = identity, typename _Proj2 = identity>
+      requires indirectly_comparable<_Iter1, _Iter2, _Pred, _Proj1, _Proj2>
+      constexpr bool
+      operator()(_Iter1 __first1, _Sent1 __last1,
+		 _Iter2 __first2, _Sent2 __last2, _Pred __pred = {},
+		 _Proj1 __proj1 = {}, _Proj2 __proj2 = {}) const
+      {
+	return __first2 == __last2
+	  || !ranges::search(__first1, __last1, __first2, __last2,
+			     std::move(__pred), std::move(__proj1),
+			     std::move(__proj2)).empty();
+      }
+
+    template<forward_range _Range1, forward_range _Range2,
+	     typename _Pred = ranges::equal_to,
+	     typename _Proj1 = identity, typename _Proj2 = identity>
+      requires indirectly_comparable<iterator_t<_Range1>, iterator_t<_Range2>,
+				     _Pred, _Proj1, _Proj2>
+      constexpr bool
+      operator()(_Range1&& __r1, _Range2&& __r2, _Pred __pred = {},
+		 _Proj1 __proj1 = {}, _Proj2 __proj2 = {}) const
+      {
+	return (*this)(ranges::begin(__r1), ranges::end(__r1),
+		       ranges::begin(__r2), ranges::end(__r2),
+		       std::move(__pred),
+		       std::move(__proj1), std::move(__proj2));
+      }
+  };
+
+  inline constexpr __contains_subrange_fn contains_subrange{};
+
+  struct __find_last_if_fn
+  {
+    template<forward_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     typename _Proj = identity,
+	     indirect_unary_predicate<projected<_Iter, _Proj>> _Pred>
+      constexpr subrange<_Iter>
+      operator()(_Iter __first, _Sent __last,
+		 _Pred __pred, _Proj __proj = {}) const
+      {
+	if constexpr (bidirectional_iterator<_Iter>)
+	  {
+	    // Search backwards from the end and stop at the first match.
+	    _Iter __lasti = ranges::next(__first, __last);
+	    for (_Iter __i = __lasti; __i != __first; )
+	      {
+		--__i;
+		if (std::__invoke(__pred, std::__invoke(__proj, *__i)))
+		  return {std::move(__i), std::move(__lasti)};
+	      }
+	    return {__lasti, __lasti};
+	  }
+	else
+	  {
+	    _Iter __found;
+	    bool __any = false;
+	    for (; __first != __last; ++__first)
+	      if (std::__invoke(__pred, std::__invoke(__proj, *__first)))
+		{
+		  __found = __first;
+		  __any = true;
+		}
+	    if (!__any)
+	      return {__first, __first};
+	    return {std::move(__found), std::move(__first)};
+	  }
+      }
+
+    template<forward_range _Range, typename _Proj = identity,
+	     indirect_unary_predicate<projected<iterator_t<_Range>, _Proj>>
+	       _Pred>
+      constexpr borrowed_subrange_t<_Range>
+      operator()(_Range&& __r, _Pred __pred, _Proj __proj = {}) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r),
+		       std::move(__pred), std::move(__proj));
+      }
+  };
+
+  inline constexpr __find_last_if_fn find_last_if{};
+
+  struct __find_last_fn
+  {
+    template<forward_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     typename _Tp, typename _Proj = identity>
+      requires indirect_binary_predicate<ranges::equal_to,
+					 projected<_Iter, _Proj>, const _Tp*>
+      constexpr subrange<_Iter>
+      operator()(_Iter __first, _Sent __last,
+		 const _Tp& __value, _Proj __proj = {}) const
+      {
+	auto __pred = [&__value] <typename _Up> (_Up&& __arg) -> bool {
+	  return std::forward<_Up>(__arg) == __value;
+	};
+	return ranges::find_last_if(std::move(__first), std::move(__last),
+				    __pred, std::move(__proj));
+      }
+
+    template<forward_range _Range, typename _Tp, typename _Proj = identity>
+      requires indirect_binary_predicate<ranges::equal_to,
+					 projected<iterator_t<_Range>, _Proj>,
+					 const _Tp*>
+      constexpr borrowed_subrange_t<_Range>
+      operator()(_Range&& __r, const _Tp& __value, _Proj __proj = {}) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r),
+		       __value, std::move(__proj));
+      }
+  };
+
+  inline constexpr __find_last_fn find_last{};
+
+  struct __find_last_if_not_fn
+  {
+    template<forward_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     typename _Proj = identity,
+	     indirect_unary_predicate<projected<_Iter, _Proj>> _Pred>
+      constexpr subrange<_Iter>
+      operator()(_Iter __first, _Sent __last,
+		 _Pred __pred, _Proj __proj = {}) const
+      {
+	auto __not_pred = [&__pred] <typename _Up> (_Up&& __arg) -> bool {
+	  return !std::__invoke(__pred, std::forward<_Up>(__arg));
+	};
+	return ranges::find_last_if(std::move(__first), std::move(__last),
+				    __not_pred, std::move(__proj));
+      }
+
+    template<forward_range _Range, typename _Proj = identity,
+	     indirect_unary_predicate<projected<iterator_t<_Range>, _Proj>>
+	       _Pred>
+      constexpr borrowed_subrange_t<_Range>
+      operator()(_Range&& __r, _Pred __pred, _Proj __proj = {}) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r),
+		       std::move(__pred), std::move(__proj));
+      }
+  };
+
+  inline constexpr __find_last_if_not_fn find_last_if_not{};
+
+  struct __starts_with_fn
+  {
+    template<input_iterator _Iter1, sentinel_for<_Iter1> _Sent1,
+	     input_iterator _Iter2, sentinel_for<_Iter2> _Sent2,
+	     typename _Pred = ranges::equal_to,
+	     typename _Proj1 = identity, typename _Proj2 = identity>
+      requires indirectly_comparable<_Iter1, _Iter2, _Pred, _Proj1, _Proj2>
+      constexpr bool
+      operator()(_Iter1 __first1, _Sent1 __last1,
+		 _Iter2 __first2, _Sent2 __last2, _Pred __pred = {},
+		 _Proj1 __proj1 = {}, _Proj2 __proj2 = {}) const
+      {
+	if constexpr (sized_sentinel_for<_Sent1, _Iter1>
+		      && sized_sentinel_for<_Sent2, _Iter2>)
+	  {
+	    // Compare only the prefix, which ranges::equal does by memcmp
+	    // for contiguous ranges of integers.
+	    auto __n1 = __last1 - __first1;
+	    auto __n2 = __last2 - __first2;
+	    if (__n1 < __n2)
+	      return false;
+	    if constexpr (random_access_iterator<_Iter1>)
+	      return ranges::equal(__first1, __first1 + __n2,
+				   std::move(__first2), std::move(__last2),
+				   std::move(__pred),
+				   std::move(__proj1), std::move(__proj2));
+	  }
+	return ranges::mismatch(std::move(__first1), std::move(__last1),
+				std::move(__first2), __last2,
+				std::move(__pred),
+				std::move(__proj1), std::move(__proj2)).in2
+	  == __last2;
+      }
+
+    template<input_range _Range1, input_range _Range2,
+	     typename _Pred = ranges::equal_to,
+	     typename _Proj1 = identity, typename _Proj2 = identity>
+      requires indirectly_comparable<iterator_t<_Range1>, iterator_t<_Range2>,
+				     _Pred, _Proj1, _Proj2>
+      constexpr bool
+      operator()(_Range1&& __r1, _Range2&& __r2, _Pred __pred = {},
+		 _Proj1 __proj1 = {}, _Proj2 __proj2 = {}) const
+      {
+	return (*this)(ranges::begin(__r1), ranges::end(__r1),
+		       ranges::begin(__r2), ranges::end(__r2),
+		       std::move(__pred),
+		       std::move(__proj1), std::move(__proj2));
+      }
+  };
+
+  inline constexpr __starts_with_fn starts_with{};
+
+  struct __ends_with_fn
+  {
+    template<input_iterator _Iter1, sentinel_for<_Iter1> _Sent1,
+	     input_iterator _Iter2, sentinel_for<_Iter2> _Sent2,
+	     typename _Pred = ranges::equal_to,
+	     typename _Proj1 = identity, typename _Proj2 = identity>
+      requires (forward_iterator<_Iter1> || sized_sentinel_for<_Sent1, _Iter1>)
+	&& (forward_iterator<_Iter2> || sized_sentinel_for<_Sent2, _Iter2>)
+	&& indirectly_comparable<_Iter1, _Iter2, _Pred, _Proj1, _Proj2>
+      constexpr bool
+      operator()(_Iter1 __first1, _Sent1 __last1,
+		 _Iter2 __first2, _Sent2 __last2, _Pred __pred = {},
+		 _Proj1 __proj1 = {}, _Proj2 __proj2 = {}) const
+      {
+	auto __n1 = ranges::distance(__first1, __last1);
+	auto __n2 = ranges::distance(__first2, __last2);
+	if (__n1 < __n2)
+	  return false;
+	ranges::advance(__first1, __n1 - __n2);
+	return ranges::equal(std::move(__first1), std::move(__last1),
+			     std::move(__first2), std::move(__last2),
+			     std::move(__pred),
+			     std::move(__proj1), std::move(__proj2));
+      }
+
+    template<input_range _Range1, input_range _Range2,
+	     typename _Pred = ranges::equal_to,
+	     typename _Proj1 = identity, typename _Proj2 = identity>
+      requires (forward_range<_Range1> || sized_range<_Range1>)
+	&& (forward_range<_Range2> || sized_range<_Range2>)
+	&& indirectly_comparable<iterator_t<_Range1>, iterator_t<_Range2>,
+				 _Pred, _Proj1, _Proj2>
+      constexpr bool
+      operator()(_Range1&& __r1, _Range2&& __r2, _Pred __pred = {},
+		 _Proj1 __proj1 = {}, _Proj2 __proj2 = {}) const
+      {
+	if constexpr (sized_range<_Range1> && sized_range<_Range2>
+		      && !(sized_sentinel_for<sentinel_t<_Range1>,
+					      iterator_t<_Range1>>
+			   && sized_sentinel_for<sentinel_t<_Range2>,
+						 iterator_t<_Range2>>))
+	  {
+	    // Sized but not random access, such as std::list.
+	    auto __n1 = ranges::distance(__r1);
+	    auto __n2 = ranges::distance(__r2);
+	    if (__n1 < __n2)
+	      return false;
+	    return ranges::equal(ranges::next(ranges::begin(__r1), __n1 - __n2),
+				 ranges::end(__r1),
+				 ranges::begin(__r2), ranges::end(__r2),
+				 std::move(__pred),
+				 std::move(__proj1), std::move(__proj2));
+	  }
+	else
+	  return (*this)(ranges::begin(__r1), ranges::end(__r1),
+			 ranges::begin(__r2), ranges::end(__r2),
+			 std::move(__pred),
+			 std::move(__proj1), std::move(__proj2));
+      }
+  };
+
+  inline constexpr __ends_with_fn ends_with{};
+
+  template<typename _Iter, typename _Tp>
+    struct in_value_result
+    {
+      [[no_unique_address]] _Iter in;
+      [[no_unique_address]] _Tp value;
+
+      template<typename _Iter2, typename _Tp2>
+	requires convertible_to<const _Iter&, _Iter2>
+	  && convertible_to<const _Tp&, _Tp2>
+	constexpr
+	operator in_value_result<_Iter2, _Tp2>() const &
+	{ return {in, value}; }
+
+      template<typename _Iter2, typename _Tp2>
+	requires convertible_to<_Iter, _Iter2>
+	  && convertible_to<_Tp, _Tp2>
+	constexpr
+	operator in_value_result<_Iter2, _Tp2>() &&
+	{ return {std::move(in), std::move(value)}; }
+    };
+
+  template<typename _Iter, typename _Tp>
+    using fold_left_with_iter_result = in_value_result<_Iter, _Tp>;
+
+  template<typename _Iter, typename _Tp>
+    using fold_left_first_with_iter_result = in_value_result<_Iter, _Tp>;
+
+  namespace __detail
+  {
+    template<typename _Fp>
+      class __flipped
+      {
+	_Fp _M_f;
+
+      public:
+	// Only used in unevaluated operands.
+	template<typename _Tp, typename _Up>
+	  requires invocable<_Fp&, _Up, _Tp>
+	  invoke_result_t<_Fp&, _Up, _Tp>
+	  operator()(_Tp&&, _Up&&);
+      };
+
+    template<typename _Fp, typename _Tp, typename _Iter, typename _Up>
+      concept __indirectly_binary_left_foldable_impl = movable<_Tp>
+	&& movable<_Up>
+	&& convertible_to<_Tp, _Up>
+	&& invocable<_Fp&, _Up, iter_reference_t<_Iter>>
+	&& assignable_from<_Up&,
+			   invoke_result_t<_Fp&, _Up, iter_reference_t<_Iter>>>;
+
+    template<typename _Fp, typename _Tp, typename _Iter>
+      concept __indirectly_binary_left_foldable = copy_constructible<_Fp>
+	&& indirectly_readable<_Iter>
+	&& invocable<_Fp&, _Tp, iter_reference_t<_Iter>>
+	&& convertible_to<invoke_result_t<_Fp&, _Tp, iter_reference_t<_Iter>>,
+			  decay_t<invoke_result_t<_Fp&, _Tp,
+						  iter_reference_t<_Iter>>>>
+	&& __indirectly_binary_left_foldable_impl<_Fp, _Tp, _Iter,
+	     decay_t<invoke_result_t<_Fp&, _Tp, iter_reference_t<_Iter>>>>;
+
+    template<typename _Fp, typename _Tp, typename _Iter>
+      concept __indirectly_binary_right_foldable
+	= __indirectly_binary_left_foldable<__flipped<_Fp>, _Tp, _Iter>;
+  } // namespace __detail
+
+  struct __fold_left_with_iter_fn
+  {
+    template<typename _Ret_iter, typename _Iter, typename _Sent,
+	     typename _Tp, typename _Fp>
+      static constexpr auto
+      _S_impl(_Iter __first, _Sent __last, _Tp __init, _Fp __f)
+      {
+	using _Up = decay_t<invoke_result_t<_Fp&, _Tp, iter_reference_t<_Iter>>>;
+	using _Ret_type = fold_left_with_iter_result<_Ret_iter, _Up>;
+
+	if (__first == __last)
+	  return _Ret_type{std::move(__first), _Up(std::move(__init))};
+
+	_Up __accum = std::__invoke(__f, std::move(__init), *__first);
+	for (++__first; __first != __last; ++__first)
+	  __accum = std::__invoke(__f, std::move(__accum), *__first);
+	return _Ret_type{std::move(__first), std::move(__accum)};
+      }
+
+    template<input_iterator _Iter, sentinel_for<_Iter> _Sent, typename _Tp,
+	     __detail::__indirectly_binary_left_foldable<_Tp, _Iter> _Fp>
+      constexpr auto
+      operator()(_Iter __first, _Sent __last, _Tp __init, _Fp __f) const
+      {
+	using _Ret_iter = _Iter;
+	return _S_impl<_Ret_iter>(std::move(__first), __last,
+				  std::move(__init), std::move(__f));
+      }
+
+    template<input_range _Range, typename _Tp,
+	     __detail::__indirectly_binary_left_foldable<_Tp,
+							 iterator_t<_Range>> _Fp>
+      constexpr auto
+      operator()(_Range&& __r, _Tp __init, _Fp __f) const
+      {
+	using _Ret_iter = borrowed_iterator_t<_Range>;
+	return _S_impl<_Ret_iter>(ranges::begin(__r), ranges::end(__r),
+				  std::move(__init), std::move(__f));
+      }
+  };
+
+  inline constexpr __fold_left_with_iter_fn fold_left_with_iter{};
+
+  struct __fold_left_fn
+  {
+    template<input_iterator _Iter, sentinel_for<_Iter> _Sent, typename _Tp,
+	     __detail::__indirectly_binary_left_foldable<_Tp, _Iter> _Fp>
+      constexpr auto
+      operator()(_Iter __first, _Sent __last, _Tp __init, _Fp __f) const
+      {
+	return ranges::fold_left_with_iter(std::move(__first), __last,
+					   std::move(__init),
+					   std::move(__f)).value;
+      }
+
+    template<input_range _Range, typename _Tp,
+	     __detail::__indirectly_binary_left_foldable<_Tp,
+							 iterator_t<_Range>> _Fp>
+      constexpr auto
+      operator()(_Range&& __r, _Tp __init, _Fp __f) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r),
+		       std::move(__init), std::move(__f));
+      }
+  };
+
+  inline constexpr __fold_left_fn fold_left{};
+
+  struct __fold_left_first_with_iter_fn
+  {
+    template<typename _Ret_iter, typename _Iter, typename _Sent, typename _Fp>
+      static constexpr auto
+      _S_impl(_Iter __first, _Sent __last, _Fp __f)
+      {
+	using _Up = decltype(ranges::fold_left(std::move(__first), __last,
+					       iter_value_t<_Iter>(*__first),
+					       __f));
+	using _Ret_type
+	  = fold_left_first_with_iter_result<_Ret_iter, optional<_Up>>;
+
+	if (__first == __last)
+	  return _Ret_type{std::move(__first), optional<_Up>()};
+
+	optional<_Up> __init(in_place, *__first);
+	for (++__first; __first != __last; ++__first)
+	  *__init = std::__invoke(__f, std::move(*__init), *__first);
+	return _Ret_type{std::move(__first), std::move(__init)};
+      }
+
+    template<input_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     __detail::__indirectly_binary_left_foldable<iter_value_t<_Iter>,
+							 _Iter> _Fp>
+      requires constructible_from<iter_value_t<_Iter>, iter_reference_t<_Iter>>
+      constexpr auto
+      operator()(_Iter __first, _Sent __last, _Fp __f) const
+      {
+	using _Ret_iter = _Iter;
+	return _S_impl<_Ret_iter>(std::move(__first), __last, std::move(__f));
+      }
+
+    template<input_range _Range,
+	     __detail::__indirectly_binary_left_foldable<
+	       range_value_t<_Range>, iterator_t<_Range>> _Fp>
+      requires constructible_from<range_value_t<_Range>,
+				  range_reference_t<_Range>>
+      constexpr auto
+      operator()(_Range&& __r, _Fp __f) const
+      {
+	using _Ret_iter = borrowed_iterator_t<_Range>;
+	return _S_impl<_Ret_iter>(ranges::begin(__r), ranges::end(__r),
+				  std::move(__f));
+      }
+  };
+
+  inline constexpr __fold_left_first_with_iter_fn fold_left_first_with_iter{};
+
+  struct __fold_left_first_fn
+  {
+    template<input_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     __detail::__indirectly_binary_left_foldable<iter_value_t<_Iter>,
+							 _Iter> _Fp>
+      requires constructible_from<iter_value_t<_Iter>, iter_reference_t<_Iter>>
+      constexpr auto
+      operator()(_Iter __first, _Sent __last, _Fp __f) const
+      {
+	return ranges::fold_left_first_with_iter(std::move(__first), __last,
+						 std::move(__f)).value;
+      }
+
+    template<input_range _Range,
+	     __detail::__indirectly_binary_left_foldable<
+	       range_value_t<_Range>, iterator_t<_Range>> _Fp>
+      requires constructible_from<range_value_t<_Range>,
+				  range_reference_t<_Range>>
+      constexpr auto
+      operator()(_Range&& __r, _Fp __f) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r), std::move(__f));
+      }
+  };
+
+  inline constexpr __fold_left_first_fn fold_left_first{};
+
+  struct __fold_right_fn
+  {
+    template<bidirectional_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     typename _Tp,
+	     __detail::__indirectly_binary_right_foldable<_Tp, _Iter> _Fp>
+      constexpr auto
+      operator()(_Iter __first, _Sent __last, _Tp __init, _Fp __f) const
+      {
+	using _Up = decay_t<invoke_result_t<_Fp&, iter_reference_t<_Iter>, _Tp>>;
+
+	if (__first == __last)
+	  return _Up(std::move(__init));
+
+	_Iter __tail = ranges::next(__first, __last);
+	_Up __accum = std::__invoke(__f, *--__tail, std::move(__init));
+	while (__first != __tail)
+	  __accum = std::__invoke(__f, *--__tail, std::move(__accum));
+	return __accum;
+      }
+
+    template<bidirectional_range _Range, typename _Tp,
+	     __detail::__indirectly_binary_right_foldable<_Tp,
+							  iterator_t<_Range>> _Fp>
+      constexpr auto
+      operator()(_Range&& __r, _Tp __init, _Fp __f) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r),
+		       std::move(__init), std::move(__f));
+      }
+  };
+
+  inline constexpr __fold_right_fn fold_right{};
+
+  struct __fold_right_last_fn
+  {
+    template<bidirectional_iterator _Iter, sentinel_for<_Iter> _Sent,
+	     __detail::__indirectly_binary_right_foldable<iter_value_t<_Iter>,
+							  _Iter> _Fp>
+      requires constructible_from<iter_value_t<_Iter>, iter_reference_t<_Iter>>
+      constexpr auto
+      operator()(_Iter __first, _Sent __last, _Fp __f) const
+      {
+	using _Up = decltype(ranges::fold_right(__first, __last,
+						iter_value_t<_Iter>(*__first),
+						__f));
+
+	if (__first == __last)
+	  return optional<_Up>();
+
+	_Iter __tail = ranges::prev(ranges::next(__first, std::move(__last)));
+	return optional<_Up>(in_place,
+			     ranges::fold_right(std::move(__first), __tail,
+						iter_value_t<_Iter>(*__tail),
+						std::move(__f)));
+      }
+
+    template<bidirectional_range _Range,
+	     __detail::__indirectly_binary_right_foldable<
+	       range_value_t<_Range>, iterator_t<_Range>> _Fp>
+      requires constructible_from<range_value_t<_Range>,
+				  range_reference_t<_Range>>
+      constexpr auto
+      operator()(_Range&& __r, _Fp __f) const
+      {
+	return (*this)(ranges::begin(__r), ranges::end(__r), std::move(__f));
+      }
+  };
+
+  inline constexpr __fold_right_last_fn fold_right_last{};
+
+  struct __shift_left_fn
+  {
+    template<permutable _Iter, sentinel_for<_Iter> _Sent>
+      constexpr subrange<_Iter>
+      operator()(_Iter __first, _Sent __last,
+		 iter_difference_t<_Iter> __n) const
+      {
+	__glibcxx_assert(__n >= 0);
+	if (__n == 0)
+	  return {__first, ranges::next(__first, __last)};
+
+	auto __mid = ranges::next(__first, __n, __last);
+	if (__mid == __last)
+	  return {__first, __first};
+	// ranges::move is a memmove for trivially copyable elements.
+	return {__first, ranges::move(std::move(__mid), std::move(__last),
+				      __first).out};
+      }
+
+    template<forward_range _Range>
+      requires permutable<iterator_t<_Range>>
+      constexpr borrowed_subrange_t<_Range>
+      operator()(_Range&& __r, range_difference_t<_Range> __n) const
+      { return (*this)(ranges::begin(__r), ranges::end(__r), __n); }
+  };
+
+  inline constexpr __shift_left_fn shift_left{};
+
+  struct __shift_right_fn
+  {
+    template<permutable _Iter, sentinel_for<_Iter> _Sent>
+      constexpr subrange<_Iter>
+      operator()(_Iter __first, _Sent __last,
+		 iter_difference_t<_Iter> __n) const
+      {
+	__glibcxx_assert(__n >= 0);
+	_Iter __lasti = ranges::next(__first, __last);
+	if (__n == 0)
+	  return {std::move(__first), std::move(__lasti)};
+
+	if constexpr (bidirectional_iterator<_Iter>)
+	  {
+	    auto __mid = ranges::next(__lasti, -__n, __first);
+	    if (__mid == __first)
+	      return {__lasti, __lasti};
+	    // ranges::move_backward is a memmove for trivially copyable
+	    // elements.
+	    return {ranges::move_backward(std::move(__first), std::move(__mid),
+					  __lasti).out, __lasti};
+	  }
+	else
+	  {
+	    // The elements shifted out are left in a valid but unspecified
+	    // state, so a rotation does it in one pass.
+	    auto __len = ranges::distance(__first, __lasti);
+	    if (__n >= __len)
+	      return {__lasti, __lasti};
+	    auto __mid = ranges::next(__first, __len - __n);
+	    return {ranges::rotate(std::move(__first), std::move(__mid),
+				   __lasti).begin(), __lasti};
+	  }
+      }
+
+    template<forward_range _Range>
+      requires permutable<iterator_t<_Range>>
+      constexpr borrowed_subrange_t<_Range>
+      operator()(_Range&& __r, range_difference_t<_Range> __n) const
+      { return (*this)(ranges::begin(__r), ranges::end(__r), __n); }
+  };
+
+  inline constexpr __shift_right_fn shift_right{};
+
 } // namespace ranges
 
-#define __cpp_lib_shift 201806L
+#if __cplusplus > 202002L
+# define __cpp_lib_ranges_contains 202207L
+# define __cpp_lib_ranges_find_last 202207L
+# define __cpp_lib_ranges_fold 202207L
+# define __cpp_lib_ranges_starts_ends_with 202106L
+# define __cpp_lib_shift 202202L
+#else
+# define __cpp_lib_shift 201806L
+#endif
   template<typename _ForwardIterator>
     constexpr _ForwardIterator
     shift_left(_ForwardIterator __first, _ForwardIterator __last,
@@ -0,0 +1,1687 @@
+// shared_ptr and weak_ptr implementation details -*- C++ -*-
+
+// Copyright (C) 2007-2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+// GCC Note: Based on files from version 1.32.0 of the Boost library.
+
+//  shared_count.hpp
+//  Copyright (c) 2001, 2002, 2003 Peter Dimov and Multi Media Ltd.
+
+//  shared_ptr.hpp
+//  Copyright (C) 1998, 1999 Greg Colvin and Beman Dawes.
+//  Copyright (C) 2001, 2002, 2003 Peter Dimov
+
+//  weak_ptr.hpp
+//  Copyright (C) 2001, 2002, 2003 Peter Dimov
+
+//  enable_shared_from_this.hpp
+//  Copyright (C) 2002 Peter Dimov
+
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/** @file bits/shared_ptr_base.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{memory}
+ */
+
+#ifndef _SHARED_PTR_BASE_H
+#define _SHARED_PTR_BASE_H 1
+
+#pragma GCC system_header
+
+#include <bits/allocated_ptr.h>
+#include <bits/exception_defines.h>
+#include <bits/functexcept.h>
+#include <bits/functional_hash.h>
+#include <bits/refwrap.h>
+#include <bits/stl_function.h>
+#include <bits/unique_ptr.h>
+#include <ext/aligned_buffer.h>
+#include <cstdint>
+#include <new>
+#if __cplusplus > 201703L
+# include <compare>
+#endif
+
+// Width in bits of the use and weak counts of a shared_ptr: 8, 16 or 32.
+// An object may have at most 2^width - 1 owners, and as many weak_ptrs;
+// one more calls std::__throw_overflow_error(), which aborts.
+#if !defined(MODM_SHARED_PTR_COUNT_WIDTH)
+#define MODM_SHARED_PTR_COUNT_WIDTH 16
+#endif
+
+// Define to 1 if shared_ptrs or weak_ptrs to the same object are copied
+// or destroyed both in interrupt handlers (or threads) and elsewhere.
+// On AVR the counts are then updated with interrupts disabled.
+#if !defined(MODM_SHARED_PTR_ATOMIC)
+#define MODM_SHARED_PTR_ATOMIC 0
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief How the reference counts of a shared_ptr are updated.
+   *
+   *  _S_single uses plain loads and stores.  _S_atomic makes every update
+   *  indivisible: on AVR by disabling interrupts for its duration, on
+   *  other targets with atomic instructions.
+   */
+  enum _Lock_policy { _S_single, _S_atomic };
+
+  // The policy used by std::shared_ptr and std::weak_ptr.
+  static const _Lock_policy __default_lock_policy
+    = MODM_SHARED_PTR_ATOMIC ? _S_atomic : _S_single;
+
+#if MODM_SHARED_PTR_COUNT_WIDTH == 8
+  typedef std::uint8_t _Sp_count_type;
+#elif MODM_SHARED_PTR_COUNT_WIDTH == 16
+  typedef std::uint16_t _Sp_count_type;
+#elif MODM_SHARED_PTR_COUNT_WIDTH == 32
+  typedef std::uint32_t _Sp_count_type;
+#else
+# error "MODM_SHARED_PTR_COUNT_WIDTH must be 8, 16 or 32"
+#endif
+
+  // A count that would wrap to zero would free the object while it is
+  // still referenced, so it is a hard failure in every build.
+  [[__noreturn__]] inline void
+  __throw_sp_count_overflow()
+  { __throw_overflow_error(__N("reference count overflow")); }
+
+  // Updates of a use or weak count under a lock policy.  _S_release and
+  // _S_add_ref_nonzero report whether the count was not zero before.
+  template<_Lock_policy _Lp>
+    struct _Sp_counter;
+
+  template<>
+    struct _Sp_counter<_S_single>
+    {
+      static void
+      _S_add_ref(_Sp_count_type& __c) noexcept
+      {
+	if (__builtin_expect(__c == _Sp_count_type(-1), false))
+	  __throw_sp_count_overflow();
+	++__c;
+      }
+
+      static bool
+      _S_add_ref_nonzero(_Sp_count_type& __c) noexcept
+      {
+	if (__c == 0)
+	  return false;
+	_S_add_ref(__c);
+	return true;
+      }
+
+      static bool
+      _S_release(_Sp_count_type& __c) noexcept
+      { return --__c == 0; }
+
+      static _Sp_count_type
+      _S_get(const _Sp_count_type& __c) noexcept
+      { return __c; }
+    };
+
+#if defined(__AVR__)
+  // Keeps interrupts disabled during its lifetime and then restores the
+  // interrupt flag.  AVR has a single core, so this is all it takes.
+  class _Sp_irq_guard
+  {
+  public:
+    _Sp_irq_guard() noexcept
+    { __asm__ __volatile__ ("in %0, __SREG__" "\n\t" "cli"
+			    : "=r" (_M_sreg) : : "memory"); }
+
+    ~_Sp_irq_guard()
+    { __asm__ __volatile__ ("out __SREG__, %0" : : "r" (_M_sreg) : "memory"); }
+
+    _Sp_irq_guard(const _Sp_irq_guard&) = delete;
+    _Sp_irq_guard& operator=(const _Sp_irq_guard&) = delete;
+
+  private:
+    unsigned char _M_sreg;
+  };
+
+  template<>
+    struct _Sp_counter<_S_atomic>
+    {
+      static void
+      _S_add_ref(_Sp_count_type& __c) noexcept
+      {
+	_Sp_irq_guard __guard;
+	_Sp_counter<_S_single>::_S_add_ref(__c);
+      }
+
+      static bool
+      _S_add_ref_nonzero(_Sp_count_type& __c) noexcept
+      {
+	_Sp_irq_guard __guard;
+	return _Sp_counter<_S_single>::_S_add_ref_nonzero(__c);
+      }
+
+      static bool
+      _S_release(_Sp_count_type& __c) noexcept
+      {
+	_Sp_irq_guard __guard;
+	return _Sp_counter<_S_single>::_S_release(__c);
+      }
+
+      static _Sp_count_type
+      _S_get(const _Sp_count_type& __c) noexcept
+      {
+	_Sp_irq_guard __guard;
+	return __c;
+      }
+    };
+#else
+  template<>
+    struct _Sp_counter<_S_atomic>
+    {
+      static void
+      _S_add_ref(_Sp_count_type& __c) noexcept
+      {
+	if (__builtin_expect(__atomic_fetch_add(&__c, 1, __ATOMIC_RELAXED)
+			     == _Sp_count_type(-1), false))
+	  __throw_sp_count_overflow();
+      }
+
+      static bool
+      _S_add_ref_nonzero(_Sp_count_type& __c) noexcept
+      {
+	_Sp_count_type __count = __atomic_load_n(&__c, __ATOMIC_RELAXED);
+	do
+	  {
+	    if (__count == 0)
+	      return false;
+	    if (__builtin_expect(__count == _Sp_count_type(-1), false))
+	      __throw_sp_count_overflow();
+	  }
+	while (!__atomic_compare_exchange_n(&__c, &__count, __count + 1,
+					    true, __ATOMIC_ACQ_REL,
+					    __ATOMIC_RELAXED));
+	return true;
+      }
+
+      static bool
+      _S_release(_Sp_count_type& __c) noexcept
+      { return __atomic_sub_fetch(&__c, 1, __ATOMIC_ACQ_REL) == 0; }
+
+      static _Sp_count_type
+      _S_get(const _Sp_count_type& __c) noexcept
+      { return __atomic_load_n(&__c, __ATOMIC_RELAXED); }
+    };
+#endif
+
+  // An address unique to _Tp, which identifies the type of a deleter in
+  // std::get_deleter without RTTI.
+  template<typename _Tp>
+    void
+    __sp_type_tag()
+    { }
+
+  /**
+   *  @brief The control block of a shared_ptr.
+   *
+   *  The kind of control block is known by a single pointer to a function
+   *  that destroys the owned object, frees the block or finds the deleter,
+   *  instead of virtual functions, whose tables avr-gcc keeps in RAM.
+   *  The weak count is one more than the number of weak_ptrs while the
+   *  use count is not zero.
+   */
+  template<_Lock_policy _Lp = __default_lock_policy>
+    class _Sp_counted_base
+    {
+    protected:
+      enum _Op { _S_dispose, _S_destroy, _S_get_deleter };
+
+      typedef void* (*_Manager)(_Sp_counted_base*, _Op, void (*)());
+
+      explicit
+      _Sp_counted_base(_Manager __manager) noexcept
+      : _M_manager(__manager), _M_use_count(1), _M_weak_count(1)
+      { }
+
+    public:
+      _Sp_counted_base(const _Sp_counted_base&) = delete;
+      _Sp_counted_base& operator=(const _Sp_counted_base&) = delete;
+
+      void
+      _M_add_ref_copy() noexcept
+      { _Sp_counter<_Lp>::_S_add_ref(_M_use_count); }
+
+      // Add an owner unless the object is already gone.
+      bool
+      _M_add_ref_lock_nothrow() noexcept
+      { return _Sp_counter<_Lp>::_S_add_ref_nonzero(_M_use_count); }
+
+      void
+      _M_add_ref_lock()
+      {
+	if (!_M_add_ref_lock_nothrow())
+	  __throw_bad_weak_ptr();
+      }
+
+      void
+      _M_release() noexcept
+      {
+	if (_Sp_counter<_Lp>::_S_release(_M_use_count))
+	  {
+	    _M_manager(this, _S_dispose, nullptr);
+	    _M_weak_release();
+	  }
+      }
+
+      void
+      _M_weak_add_ref() noexcept
+      { _Sp_counter<_Lp>::_S_add_ref(_M_weak_count); }
+
+      void
+      _M_weak_release() noexcept
+      {
+	if (_Sp_counter<_Lp>::_S_release(_M_weak_count))
+	  _M_manager(this, _S_destroy, nullptr);
+      }
+
+      long
+      _M_get_use_count() const noexcept
+      { return _Sp_counter<_Lp>::_S_get(_M_use_count); }
+
+      void*
+      _M_get_deleter(void (*__tag)()) noexcept
+      { return _M_manager(this, _S_get_deleter, __tag); }
+
+    private:
+      _Manager _M_manager;
+      _Sp_count_type _M_use_count;
+      _Sp_count_type _M_weak_count;
+    };
+
+  // Forward declarations.
+  template<typename _Tp, _Lock_policy _Lp = __default_lock_policy>
+    class __shared_ptr;
+
+  template<typename _Tp, _Lock_policy _Lp = __default_lock_policy>
+    class __weak_ptr;
+
+  template<typename _Tp, _Lock_policy _Lp = __default_lock_policy>
+    class __enable_shared_from_this;
+
+  template<typename _Tp>
+    class shared_ptr;
+
+  template<typename _Tp>
+    class weak_ptr;
+
+  template<typename _Tp>
+    struct owner_less;
+
+  template<typename _Tp>
+    class enable_shared_from_this;
+
+  template<_Lock_policy _Lp = __default_lock_policy>
+    class __weak_count;
+
+  template<_Lock_policy _Lp = __default_lock_policy>
+    class __shared_count;
+
+  // Counted ptr with no deleter or allocator support
+  template<typename _Ptr, _Lock_policy _Lp>
+    class _Sp_counted_ptr final : public _Sp_counted_base<_Lp>
+    {
+      typedef _Sp_counted_base<_Lp> _Base;
+
+    public:
+      explicit
+      _Sp_counted_ptr(_Ptr __p) noexcept
+      : _Base(&_S_manage), _M_ptr(__p)
+      { }
+
+    private:
+      static void*
+      _S_manage(_Base* __base, typename _Base::_Op __op, void (*)())
+      {
+	_Sp_counted_ptr* __self = static_cast<_Sp_counted_ptr*>(__base);
+	if (__op == _Base::_S_dispose)
+	  delete __self->_M_ptr;
+	else if (__op == _Base::_S_destroy)
+	  delete __self;
+	return nullptr;
+      }
+
+      _Ptr _M_ptr;
+    };
+
+  // Support for custom deleter and/or allocator, which are empty in most
+  // cases and then take no space.
+  template<int _Nm, typename _Tp,
+	   bool __use_ebo = !__is_final(_Tp) && __is_empty(_Tp)>
+    struct _Sp_ebo_helper;
+
+  /// Specialization using EBO.
+  template<int _Nm, typename _Tp>
+    struct _Sp_ebo_helper<_Nm, _Tp, true> : private _Tp
+    {
+      explicit _Sp_ebo_helper(const _Tp& __tp) : _Tp(__tp) { }
+      explicit _Sp_ebo_helper(_Tp&& __tp) : _Tp(std::move(__tp)) { }
+
+      static _Tp&
+      _S_get(_Sp_ebo_helper& __eboh) { return static_cast<_Tp&>(__eboh); }
+    };
+
+  /// Specialization not using EBO.
+  template<int _Nm, typename _Tp>
+    struct _Sp_ebo_helper<_Nm, _Tp, false>
+    {
+      explicit _Sp_ebo_helper(const _Tp& __tp) : _M_tp(__tp) { }
+      explicit _Sp_ebo_helper(_Tp&& __tp) : _M_tp(std::move(__tp)) { }
+
+      static _Tp&
+      _S_get(_Sp_ebo_helper& __eboh)
+      { return __eboh._M_tp; }
+
+    private:
+      _Tp _M_tp;
+    };
+
+  // Support for custom deleter and/or allocator
+  template<typename _Ptr, typename _Deleter, typename _Alloc, _Lock_policy _Lp>
+    class _Sp_counted_deleter final : public _Sp_counted_base<_Lp>
+    {
+      class _Impl : _Sp_ebo_helper<0, _Deleter>, _Sp_ebo_helper<1, _Alloc>
+      {
+	typedef _Sp_ebo_helper<0, _Deleter>	_Del_base;
+	typedef _Sp_ebo_helper<1, _Alloc>	_Alloc_base;
+
+      public:
+	_Impl(_Ptr __p, _Deleter __d, const _Alloc& __a) noexcept
+	: _Del_base(std::move(__d)), _Alloc_base(__a), _M_ptr(__p)
+	{ }
+
+	_Deleter& _M_del() noexcept { return _Del_base::_S_get(*this); }
+	_Alloc& _M_alloc() noexcept { return _Alloc_base::_S_get(*this); }
+
+	_Ptr _M_ptr;
+      };
+
+      typedef _Sp_counted_base<_Lp> _Base;
+
+    public:
+      using __allocator_type = __alloc_rebind<_Alloc, _Sp_counted_deleter>;
+
+      // __d(__p) must not throw.
+      _Sp_counted_deleter(_Ptr __p, _Deleter __d, const _Alloc& __a) noexcept
+      : _Base(&_S_manage), _M_impl(__p, std::move(__d), __a)
+      { }
+
+      ~_Sp_counted_deleter() noexcept { }
+
+    private:
+      static void*
+      _S_manage(_Base* __base, typename _Base::_Op __op, void (*__tag)())
+      {
+	_Sp_counted_deleter* __self = static_cast<_Sp_counted_deleter*>(__base);
+	switch (__op)
+	  {
+	  case _Base::_S_dispose:
+	    __self->_M_impl._M_del()(__self->_M_impl._M_ptr);
+	    break;
+	  case _Base::_S_destroy:
+	    {
+	      __allocator_type __a(__self->_M_impl._M_alloc());
+	      __allocated_ptr<__allocator_type> __guard_ptr{ __a, __self };
+	      __self->~_Sp_counted_deleter();
+	    }
+	    break;
+	  case _Base::_S_get_deleter:
+	    if (__tag == &__sp_type_tag<_Deleter>)
+	      return std::__addressof(__self->_M_impl._M_del());
+	    break;
+	  }
+	return nullptr;
+      }
+
+      _Impl _M_impl;
+    };
+
+  // Deleter of the array owned by a shared_ptr<T[]>.
+  struct __sp_array_delete
+  {
+    template<typename _Yp>
+      void operator()(_Yp* __p) const { delete[] __p; }
+  };
+
+  // The allocator given to allocate_shared, which constructs the object
+  // in the same allocation as the control block.
+  template<typename _Alloc>
+    struct _Sp_alloc_shared_tag
+    {
+      const _Alloc& _M_a;
+    };
+
+  // The control block and the object it owns, from a single allocation.
+  template<typename _Tp, typename _Alloc, _Lock_policy _Lp>
+    class _Sp_counted_ptr_inplace final : public _Sp_counted_base<_Lp>
+    {
+      class _Impl : _Sp_ebo_helper<0, _Alloc>
+      {
+	typedef _Sp_ebo_helper<0, _Alloc>	_A_base;
+
+      public:
+	explicit _Impl(_Alloc __a) noexcept : _A_base(__a) { }
+
+	_Alloc& _M_alloc() noexcept { return _A_base::_S_get(*this); }
+
+	__gnu_cxx::__aligned_buffer<_Tp> _M_storage;
+      };
+
+      typedef _Sp_counted_base<_Lp> _Base;
+
+    public:
+      using __allocator_type = __alloc_rebind<_Alloc, _Sp_counted_ptr_inplace>;
+
+      // Alloc parameter is not a reference so doesn't alias anything in __args
+      template<typename... _Args>
+	_Sp_counted_ptr_inplace(_Alloc __a, _Args&&... __args)
+	: _Base(&_S_manage), _M_impl(__a)
+	{
+	  allocator_traits<_Alloc>::construct(__a, _M_ptr(),
+	      std::forward<_Args>(__args)...); // might throw
+	}
+
+      ~_Sp_counted_ptr_inplace() noexcept { }
+
+      _Tp*
+      _M_ptr() noexcept
+      { return _M_impl._M_storage._M_ptr(); }
+
+    private:
+      static void*
+      _S_manage(_Base* __base, typename _Base::_Op __op, void (*)())
+      {
+	_Sp_counted_ptr_inplace* __self
+	  = static_cast<_Sp_counted_ptr_inplace*>(__base);
+	if (__op == _Base::_S_dispose)
+	  allocator_traits<_Alloc>::destroy(__self->_M_impl._M_alloc(),
+					    __self->_M_ptr());
+	else if (__op == _Base::_S_destroy)
+	  {
+	    __allocator_type __a(__self->_M_impl._M_alloc());
+	    __allocated_ptr<__allocator_type> __guard_ptr{ __a, __self };
+	    __self->~_Sp_counted_ptr_inplace();
+	  }
+	return nullptr;
+      }
+
+      _Impl _M_impl;
+    };
+
+  template<_Lock_policy _Lp>
+    class __shared_count
+    {
+      template<typename _Tp>
+	struct __not_alloc_shared_tag { using type = void; };
+
+      template<typename _Tp>
+	struct __not_alloc_shared_tag<_Sp_alloc_shared_tag<_Tp>> { };
+
+    public:
+      constexpr __shared_count() noexcept : _M_pi(0)
+      { }
+
+      template<typename _Ptr>
+	explicit
+	__shared_count(_Ptr __p) : _M_pi(0)
+	{
+	  __try
+	    {
+	      _M_pi = new _Sp_counted_ptr<_Ptr, _Lp>(__p);
+	    }
+	  __catch(...)
+	    {
+	      delete __p;
+	      __throw_exception_again;
+	    }
+	}
+
+      template<typename _Ptr>
+	__shared_count(_Ptr __p, /* is_array = */ false_type)
+	: __shared_count(__p)
+	{ }
+
+      template<typename _Ptr>
+	__shared_count(_Ptr __p, /* is_array = */ true_type)
+	: __shared_count(__p, __sp_array_delete{}, allocator<void>())
+	{ }
+
+      template<typename _Ptr, typename _Deleter,
+	       typename = typename __not_alloc_shared_tag<_Deleter>::type>
+	__shared_count(_Ptr __p, _Deleter __d)
+	: __shared_count(__p, std::move(__d), allocator<void>())
+	{ }
+
+      template<typename _Ptr, typename _Deleter, typename _Alloc,
+	       typename = typename __not_alloc_shared_tag<_Deleter>::type>
+	__shared_count(_Ptr __p, _Deleter __d, _Alloc __a) : _M_pi(0)
+	{
+	  typedef _Sp_counted_deleter<_Ptr, _Deleter, _Alloc, _Lp> _Sp_cd_type;
+	  __try
+	    {
+	      typename _Sp_cd_type::__allocator_type __a2(__a);
+	      auto __guard = std::__allocate_guarded(__a2);
+	      _Sp_cd_type* __mem = __guard.get();
+	      ::new (__mem) _Sp_cd_type(__p, std::move(__d), std::move(__a));
+	      _M_pi = __mem;
+	      __guard = nullptr;
+	    }
+	  __catch(...)
+	    {
+	      __d(__p); // Call _Deleter on __p.
+	      __throw_exception_again;
+	    }
+	}
+
+      template<typename _Tp, typename _Alloc, typename... _Args>
+	__shared_count(_Tp*& __p, _Sp_alloc_shared_tag<_Alloc> __a,
+		       _Args&&... __args)
+	{
+	  typedef typename remove_cv<_Tp>::type _Up;
+	  typedef __alloc_rebind<_Alloc, _Up> _Up_alloc;
+	  typedef _Sp_counted_ptr_inplace<_Up, _Up_alloc, _Lp> _Sp_cp_type;
+	  typename _Sp_cp_type::__allocator_type __a2(__a._M_a);
+	  auto __guard = std::__allocate_guarded(__a2);
+	  _Sp_cp_type* __mem = __guard.get();
+	  auto __pi = ::new (__mem)
+	    _Sp_cp_type(_Up_alloc(__a._M_a), std::forward<_Args>(__args)...);
+	  __guard = nullptr;
+	  _M_pi = __pi;
+	  __p = __pi->_M_ptr();
+	}
+
+      // Special case for unique_ptr<_Tp,_Del> to provide the strong guarantee.
+      template<typename _Tp, typename _Del>
+	explicit
+	__shared_count(std::unique_ptr<_Tp, _Del>&& __r) : _M_pi(0)
+	{
+	  // _GLIBCXX_RESOLVE_LIB_DEFECTS
+	  // 2415. Inconsistency between unique_ptr and shared_ptr
+	  if (__r.get() == nullptr)
+	    return;
+
+	  using _Ptr = typename unique_ptr<_Tp, _Del>::pointer;
+	  using _Del2 = typename conditional<is_reference<_Del>::value,
+	      reference_wrapper<typename remove_reference<_Del>::type>,
+	      _Del>::type;
+	  using _Sp_cd_type
+	    = _Sp_counted_deleter<_Ptr, _Del2, allocator<void>, _Lp>;
+	  using _Alloc = allocator<_Sp_cd_type>;
+	  using _Alloc_traits = allocator_traits<_Alloc>;
+	  _Alloc __a;
+	  _Sp_cd_type* __mem = _Alloc_traits::allocate(__a, 1);
+	  ::new (__mem) _Sp_cd_type(__r.get(),
+				    std::forward<_Del>(__r.get_deleter()),
+				    allocator<void>());
+	  __r.release();
+	  _M_pi = __mem;
+	}
+
+      // Throw bad_weak_ptr when __r._M_get_use_count() == 0.
+      explicit __shared_count(const __weak_count<_Lp>& __r);
+
+      // Does not throw if __r._M_get_use_count() == 0, caller must check.
+      explicit __shared_count(const __weak_count<_Lp>& __r, std::nothrow_t)
+	noexcept;
+
+      ~__shared_count() noexcept
+      {
+	if (_M_pi != nullptr)
+	  _M_pi->_M_release();
+      }
+
+      __shared_count(const __shared_count& __r) noexcept
+      : _M_pi(__r._M_pi)
+      {
+	if (_M_pi != 0)
+	  _M_pi->_M_add_ref_copy();
+      }
+
+      __shared_count&
+      operator=(const __shared_count& __r) noexcept
+      {
+	_Sp_counted_base<_Lp>* __tmp = __r._M_pi;
+	if (__tmp != _M_pi)
+	  {
+	    if (__tmp != 0)
+	      __tmp->_M_add_ref_copy();
+	    if (_M_pi != 0)
+	      _M_pi->_M_release();
+	    _M_pi = __tmp;
+	  }
+	return *this;
+      }
+
+      void
+      _M_swap(__shared_count& __r) noexcept
+      {
+	_Sp_counted_base<_Lp>* __tmp = __r._M_pi;
+	__r._M_pi = _M_pi;
+	_M_pi = __tmp;
+      }
+
+      long
+      _M_get_use_count() const noexcept
+      { return _M_pi != 0 ? _M_pi->_M_get_use_count() : 0; }
+
+      bool
+      _M_unique() const noexcept
+      { return this->_M_get_use_count() == 1; }
+
+      void*
+      _M_get_deleter(void (*__tag)()) const noexcept
+      { return _M_pi ? _M_pi->_M_get_deleter(__tag) : nullptr; }
+
+      bool
+      _M_less(const __shared_count& __rhs) const noexcept
+      { return std::less<_Sp_counted_base<_Lp>*>()(this->_M_pi, __rhs._M_pi); }
+
+      bool
+      _M_less(const __weak_count<_Lp>& __rhs) const noexcept
+      { return std::less<_Sp_counted_base<_Lp>*>()(this->_M_pi, __rhs._M_pi); }
+
+      // Friend function injected into enclosing namespace and found by ADL
+      friend inline bool
+      operator==(const __shared_count& __a, const __shared_count& __b) noexcept
+      { return __a._M_pi == __b._M_pi; }
+
+    private:
+      friend class __weak_count<_Lp>;
+
+      _Sp_counted_base<_Lp>*  _M_pi;
+    };
+
+
+  template<_Lock_policy _Lp>
+    class __weak_count
+    {
+    public:
+      constexpr __weak_count() noexcept : _M_pi(nullptr)
+      { }
+
+      __weak_count(const __shared_count<_Lp>& __r) noexcept
+      : _M_pi(__r._M_pi)
+      {
+	if (_M_pi != nullptr)
+	  _M_pi->_M_weak_add_ref();
+      }
+
+      __weak_count(const __weak_count& __r) noexcept
+      : _M_pi(__r._M_pi)
+      {
+	if (_M_pi != nullptr)
+	  _M_pi->_M_weak_add_ref();
+      }
+
+      __weak_count(__weak_count&& __r) noexcept
+      : _M_pi(__r._M_pi)
+      { __r._M_pi = nullptr; }
+
+      ~__weak_count() noexcept
+      {
+	if (_M_pi != nullptr)
+	  _M_pi->_M_weak_release();
+      }
+
+      __weak_count&
+      operator=(const __shared_count<_Lp>& __r) noexcept
+      {
+	_Sp_counted_base<_Lp>* __tmp = __r._M_pi;
+	if (__tmp != nullptr)
+	  __tmp->_M_weak_add_ref();
+	if (_M_pi != nullptr)
+	  _M_pi->_M_weak_release();
+	_M_pi = __tmp;
+	return *this;
+      }
+
+      __weak_count&
+      operator=(const __weak_count& __r) noexcept
+      {
+	_Sp_counted_base<_Lp>* __tmp = __r._M_pi;
+	if (__tmp != nullptr)
+	  __tmp->_M_weak_add_ref();
+	if (_M_pi != nullptr)
+	  _M_pi->_M_weak_release();
+	_M_pi = __tmp;
+	return *this;
+      }
+
+      __weak_count&
+      operator=(__weak_count&& __r) noexcept
+      {
+	if (_M_pi != nullptr)
+	  _M_pi->_M_weak_release();
+	_M_pi = __r._M_pi;
+	__r._M_pi = nullptr;
+	return *this;
+      }
+
+      void
+      _M_swap(__weak_count& __r) noexcept
+      {
+	_Sp_counted_base<_Lp>* __tmp = __r._M_pi;
+	__r._M_pi = _M_pi;
+	_M_pi = __tmp;
+      }
+
+      long
+      _M_get_use_count() const noexcept
+      { return _M_pi != nullptr ? _M_pi->_M_get_use_count() : 0; }
+
+      bool
+      _M_less(const __weak_count& __rhs) const noexcept
+      { return std::less<_Sp_counted_base<_Lp>*>()(this->_M_pi, __rhs._M_pi); }
+
+      bool
+      _M_less(const __shared_count<_Lp>& __rhs) const noexcept
+      { return std::less<_Sp_counted_base<_Lp>*>()(this->_M_pi, __rhs._M_pi); }
+
+      // Friend function injected into enclosing namespace and found by ADL
+      friend inline bool
+      operator==(const __weak_count& __a, const __weak_count& __b) noexcept
+      { return __a._M_pi == __b._M_pi; }
+
+    private:
+      friend class __shared_count<_Lp>;
+
+      _Sp_counted_base<_Lp>*  _M_pi;
+    };
+
+  // Now that __weak_count is defined we can define this constructor:
+  template<_Lock_policy _Lp>
+    inline
+    __shared_count<_Lp>::__shared_count(const __weak_count<_Lp>& __r)
+    : _M_pi(__r._M_pi)
+    {
+      if (_M_pi != nullptr)
+	_M_pi->_M_add_ref_lock();
+      else
+	__throw_bad_weak_ptr();
+    }
+
+  // Now that __weak_count is defined we can define this constructor:
+  template<_Lock_policy _Lp>
+    inline
+    __shared_count<_Lp>::
+    __shared_count(const __weak_count<_Lp>& __r, std::nothrow_t) noexcept
+    : _M_pi(__r._M_pi)
+    {
+      if (_M_pi != nullptr)
+	if (!_M_pi->_M_add_ref_lock_nothrow())
+	  _M_pi = nullptr;
+    }
+
+  // Helper traits for shared_ptr of array:
+
+  // A pointer type Y* is said to be compatible with a pointer type T* when
+  // either Y* is convertible to T* or Y is U[N] and T is U cv [].
+  template<typename _Yp_ptr, typename _Tp_ptr>
+    struct __sp_compatible_with
+    : false_type
+    { };
+
+  template<typename _Yp, typename _Tp>
+    struct __sp_compatible_with<_Yp*, _Tp*>
+    : is_convertible<_Yp*, _Tp*>::type
+    { };
+
+  template<typename _Up, size_t _Nm>
+    struct __sp_compatible_with<_Up(*)[_Nm], _Up(*)[]>
+    : true_type
+    { };
+
+  template<typename _Up, size_t _Nm>
+    struct __sp_compatible_with<_Up(*)[_Nm], const _Up(*)[]>
+    : true_type
+    { };
+
+  template<typename _Up, size_t _Nm>
+    struct __sp_compatible_with<_Up(*)[_Nm], volatile _Up(*)[]>
+    : true_type
+    { };
+
+  template<typename _Up, size_t _Nm>
+    struct __sp_compatible_with<_Up(*)[_Nm], const volatile _Up(*)[]>
+    : true_type
+    { };
+
+  // otherwise, Y* shall be convertible to T*.
+  template<typename _Tp, typename _Yp>
+    struct __sp_is_constructible
+    : is_convertible<_Yp*, _Tp*>::type
+    { };
+
+  // If T is U[N], Y(*)[N] shall be convertible to T*;
+  template<typename _Up, size_t _Nm, typename _Yp>
+    struct __sp_is_constructible<_Up[_Nm], _Yp>
+    : is_convertible<_Yp(*)[_Nm], _Up(*)[_Nm]>::type
+    { };
+
+  // if T is U[], Y(*)[] shall be convertible to T*;
+  template<typename _Up, typename _Yp>
+    struct __sp_is_constructible<_Up[], _Yp>
+    : is_convertible<_Yp(*)[], _Up(*)[]>::type
+    { };
+
+  // Define operator* and operator-> for shared_ptr<T>.
+  template<typename _Tp, _Lock_policy _Lp,
+	   bool = is_array<_Tp>::value, bool = is_void<_Tp>::value>
+    class __shared_ptr_access
+    {
+    public:
+      using element_type = _Tp;
+
+      element_type&
+      operator*() const noexcept
+      {
+	__glibcxx_assert(_M_get() != nullptr);
+	return *_M_get();
+      }
+
+      element_type*
+      operator->() const noexcept
+      {
+	_GLIBCXX_DEBUG_PEDASSERT(_M_get() != nullptr);
+	return _M_get();
+      }
+
+    private:
+      element_type*
+      _M_get() const noexcept
+      { return static_cast<const __shared_ptr<_Tp, _Lp>*>(this)->get(); }
+    };
+
+  // Define operator-> for shared_ptr<cv void>.
+  template<typename _Tp, _Lock_policy _Lp>
+    class __shared_ptr_access<_Tp, _Lp, false, true>
+    {
+    public:
+      using element_type = _Tp;
+
+      element_type*
+      operator->() const noexcept
+      {
+	auto __ptr = static_cast<const __shared_ptr<_Tp, _Lp>*>(this)->get();
+	_GLIBCXX_DEBUG_PEDASSERT(__ptr != nullptr);
+	return __ptr;
+      }
+    };
+
+  // Define operator[] for shared_ptr<T[]> and shared_ptr<T[N]>.
+  template<typename _Tp, _Lock_policy _Lp>
+    class __shared_ptr_access<_Tp, _Lp, true, false>
+    {
+    public:
+      using element_type = typename remove_extent<_Tp>::type;
+
+      element_type&
+      operator[](ptrdiff_t __i) const
+      {
+	__glibcxx_assert(_M_get() != nullptr);
+	__glibcxx_assert(!extent<_Tp>::value || __i < extent<_Tp>::value);
+	return _M_get()[__i];
+      }
+
+    private:
+      element_type*
+      _M_get() const noexcept
+      { return static_cast<const __shared_ptr<_Tp, _Lp>*>(this)->get(); }
+    };
+
+  template<typename _Tp, _Lock_policy _Lp>
+    class __shared_ptr
+    : public __shared_ptr_access<_Tp, _Lp>
+    {
+    public:
+      using element_type = typename remove_extent<_Tp>::type;
+
+    private:
+      // Constraint for taking ownership of a pointer of type _Yp*:
+      template<typename _Yp>
+	using _SafeConv
+	  = typename enable_if<__sp_is_constructible<_Tp, _Yp>::value>::type;
+
+      // Constraint for construction from shared_ptr and weak_ptr:
+      template<typename _Yp, typename _Res = void>
+	using _Compatible = typename
+	  enable_if<__sp_compatible_with<_Yp*, _Tp*>::value, _Res>::type;
+
+      // Constraint for assignment from shared_ptr and weak_ptr:
+      template<typename _Yp>
+	using _Assignable = _Compatible<_Yp, __shared_ptr&>;
+
+      // Constraint for construction from unique_ptr:
+      template<typename _Yp, typename _Del, typename _Res = void,
+	       typename _Ptr = typename unique_ptr<_Yp, _Del>::pointer>
+	using _UniqCompatible = typename enable_if<__and_<
+	  __sp_compatible_with<_Yp*, _Tp*>,
+	  is_convertible<_Ptr, element_type*>
+	  >::value, _Res>::type;
+
+      // Constraint for assignment from unique_ptr:
+      template<typename _Yp, typename _Del>
+	using _UniqAssignable = _UniqCompatible<_Yp, _Del, __shared_ptr&>;
+
+    public:
+      constexpr __shared_ptr() noexcept
+      : _M_ptr(0), _M_refcount()
+      { }
+
+      template<typename _Yp, typename = _SafeConv<_Yp>>
+	explicit
+	__shared_ptr(_Yp* __p)
+	: _M_ptr(__p), _M_refcount(__p, typename is_array<_Tp>::type())
+	{
+	  static_assert( !is_void<_Yp>::value, "incomplete type" );
+	  static_assert( sizeof(_Yp) > 0, "incomplete type" );
+	  _M_enable_shared_from_this_with(__p);
+	}
+
+      template<typename _Yp, typename _Deleter, typename = _SafeConv<_Yp>>
+	__shared_ptr(_Yp* __p, _Deleter __d)
+	: _M_ptr(__p), _M_refcount(__p, std::move(__d))
+	{ _M_enable_shared_from_this_with(__p); }
+
+      template<typename _Yp, typename _Deleter, typename _Alloc,
+	       typename = _SafeConv<_Yp>>
+	__shared_ptr(_Yp* __p, _Deleter __d, _Alloc __a)
+	: _M_ptr(__p), _M_refcount(__p, std::move(__d), std::move(__a))
+	{ _M_enable_shared_from_this_with(__p); }
+
+      template<typename _Deleter>
+	__shared_ptr(nullptr_t __p, _Deleter __d)
+	: _M_ptr(0), _M_refcount(__p, std::move(__d))
+	{ }
+
+      template<typename _Deleter, typename _Alloc>
+	__shared_ptr(nullptr_t __p, _Deleter __d, _Alloc __a)
+	: _M_ptr(0), _M_refcount(__p, std::move(__d), std::move(__a))
+	{ }
+
+      // Aliasing constructor
+      template<typename _Yp>
+	__shared_ptr(const __shared_ptr<_Yp, _Lp>& __r,
+		     element_type* __p) noexcept
+	: _M_ptr(__p), _M_refcount(__r._M_refcount) // never throws
+	{ }
+
+      // Aliasing constructor
+      template<typename _Yp>
+	__shared_ptr(__shared_ptr<_Yp, _Lp>&& __r,
+		     element_type* __p) noexcept
+	: _M_ptr(__p), _M_refcount()
+	{
+	  _M_refcount._M_swap(__r._M_refcount);
+	  __r._M_ptr = 0;
+	}
+
+      __shared_ptr(const __shared_ptr&) noexcept = default;
+      __shared_ptr& operator=(const __shared_ptr&) noexcept = default;
+      ~__shared_ptr() = default;
+
+      template<typename _Yp, typename = _Compatible<_Yp>>
+	__shared_ptr(const __shared_ptr<_Yp, _Lp>& __r) noexcept
+	: _M_ptr(__r._M_ptr), _M_refcount(__r._M_refcount)
+	{ }
+
+      __shared_ptr(__shared_ptr&& __r) noexcept
+      : _M_ptr(__r._M_ptr), _M_refcount()
+      {
+	_M_refcount._M_swap(__r._M_refcount);
+	__r._M_ptr = 0;
+      }
+
+      template<typename _Yp, typename = _Compatible<_Yp>>
+	__shared_ptr(__shared_ptr<_Yp, _Lp>&& __r) noexcept
+	: _M_ptr(__r._M_ptr), _M_refcount()
+	{
+	  _M_refcount._M_swap(__r._M_refcount);
+	  __r._M_ptr = 0;
+	}
+
+      template<typename _Yp, typename = _Compatible<_Yp>>
+	explicit __shared_ptr(const __weak_ptr<_Yp, _Lp>& __r)
+	: _M_refcount(__r._M_refcount) // may throw
+	{
+	  // It is now safe to copy __r._M_ptr, as
+	  // _M_refcount(__r._M_refcount) did not throw.
+	  _M_ptr = __r._M_ptr;
+	}
+
+      // If an exception is thrown this constructor has no effect.
+      template<typename _Yp, typename _Del,
+	       typename = _UniqCompatible<_Yp, _Del>>
+	__shared_ptr(unique_ptr<_Yp, _Del>&& __r)
+	: _M_ptr(__r.get()), _M_refcount()
+	{
+	  auto __raw = std::__to_address(__r.get());
+	  _M_refcount = __shared_count<_Lp>(std::move(__r));
+	  _M_enable_shared_from_this_with(__raw);
+	}
+
+      constexpr __shared_ptr(nullptr_t) noexcept : __shared_ptr() { }
+
+      template<typename _Yp>
+	_Assignable<_Yp>
+	operator=(const __shared_ptr<_Yp, _Lp>& __r) noexcept
+	{
+	  _M_ptr = __r._M_ptr;
+	  _M_refcount = __r._M_refcount; // __shared_count::op= doesn't throw
+	  return *this;
+	}
+
+      __shared_ptr&
+      operator=(__shared_ptr&& __r) noexcept
+      {
+	__shared_ptr(std::move(__r)).swap(*this);
+	return *this;
+      }
+
+      template<class _Yp>
+	_Assignable<_Yp>
+	operator=(__shared_ptr<_Yp, _Lp>&& __r) noexcept
+	{
+	  __shared_ptr(std::move(__r)).swap(*this);
+	  return *this;
+	}
+
+      template<typename _Yp, typename _Del>
+	_UniqAssignable<_Yp, _Del>
+	operator=(unique_ptr<_Yp, _Del>&& __r)
+	{
+	  __shared_ptr(std::move(__r)).swap(*this);
+	  return *this;
+	}
+
+      void
+      reset() noexcept
+      { __shared_ptr().swap(*this); }
+
+      template<typename _Yp>
+	_SafeConv<_Yp>
+	reset(_Yp* __p) // _Yp must be complete.
+	{
+	  // Catch self-reset errors.
+	  __glibcxx_assert(__p == 0 || __p != _M_ptr);
+	  __shared_ptr(__p).swap(*this);
+	}
+
+      template<typename _Yp, typename _Deleter>
+	_SafeConv<_Yp>
+	reset(_Yp* __p, _Deleter __d)
+	{ __shared_ptr(__p, std::move(__d)).swap(*this); }
+
+      template<typename _Yp, typename _Deleter, typename _Alloc>
+	_SafeConv<_Yp>
+	reset(_Yp* __p, _Deleter __d, _Alloc __a)
+	{ __shared_ptr(__p, std::move(__d), std::move(__a)).swap(*this); }
+
+      /// Return the stored pointer.
+      element_type*
+      get() const noexcept
+      { return _M_ptr; }
+
+      /// Return true if the stored pointer is not null.
+      explicit operator bool() const noexcept
+      { return _M_ptr != nullptr; }
+
+      /// Return true if use_count() == 1.
+      bool
+      unique() const noexcept
+      { return _M_refcount._M_unique(); }
+
+      /// If *this owns a pointer, return the number of owners, otherwise zero.
+      long
+      use_count() const noexcept
+      { return _M_refcount._M_get_use_count(); }
+
+      /// Exchange both the owned pointer and the stored pointer.
+      void
+      swap(__shared_ptr<_Tp, _Lp>& __other) noexcept
+      {
+	std::swap(_M_ptr, __other._M_ptr);
+	_M_refcount._M_swap(__other._M_refcount);
+      }
+
+      /** @brief Define an ordering based on ownership.
+       *
+       * This function defines a strict weak ordering between two shared_ptr
+       * or weak_ptr objects, such that one object is less than the other
+       * unless they share ownership of the same pointer, or are both empty.
+       * @{
+       */
+      template<typename _Tp1>
+	bool
+	owner_before(__shared_ptr<_Tp1, _Lp> const& __rhs) const noexcept
+	{ return _M_refcount._M_less(__rhs._M_refcount); }
+
+      template<typename _Tp1>
+	bool
+	owner_before(__weak_ptr<_Tp1, _Lp> const& __rhs) const noexcept
+	{ return _M_refcount._M_less(__rhs._M_refcount); }
+      // @}
+
+    protected:
+      // This constructor is non-standard, it is used by allocate_shared.
+      template<typename _Alloc, typename... _Args>
+	__shared_ptr(_Sp_alloc_shared_tag<_Alloc> __tag, _Args&&... __args)
+	: _M_ptr(), _M_refcount(_M_ptr, __tag, std::forward<_Args>(__args)...)
+	{ _M_enable_shared_from_this_with(_M_ptr); }
+
+      // This constructor is used by __weak_ptr::lock() and
+      // shared_ptr::shared_ptr(const weak_ptr&, std::nothrow_t).
+      __shared_ptr(const __weak_ptr<_Tp, _Lp>& __r, std::nothrow_t) noexcept
+      : _M_refcount(__r._M_refcount, std::nothrow)
+      {
+	_M_ptr = _M_refcount._M_get_use_count() ? __r._M_ptr : nullptr;
+      }
+
+      friend class __weak_ptr<_Tp, _Lp>;
+
+    private:
+
+      template<typename _Yp>
+	using __esft_base_t = decltype(__enable_shared_from_this_base(
+	      std::declval<const __shared_count<_Lp>&>(),
+	      std::declval<_Yp*>()));
+
+      // Detect an accessible and unambiguous enable_shared_from_this base.
+      template<typename _Yp, typename = void>
+	struct __has_esft_base
+	: false_type { };
+
+      template<typename _Yp>
+	struct __has_esft_base<_Yp, __void_t<__esft_base_t<_Yp>>>
+	: __not_<is_array<_Tp>> { }; // No enable shared_from_this for arrays
+
+      template<typename _Yp, typename _Yp2 = typename remove_cv<_Yp>::type>
+	typename enable_if<__has_esft_base<_Yp2>::value>::type
+	_M_enable_shared_from_this_with(_Yp* __p) noexcept
+	{
+	  if (auto __base = __enable_shared_from_this_base(_M_refcount, __p))
+	    __base->_M_weak_assign(const_cast<_Yp2*>(__p), _M_refcount);
+	}
+
+      template<typename _Yp, typename _Yp2 = typename remove_cv<_Yp>::type>
+	typename enable_if<!__has_esft_base<_Yp2>::value>::type
+	_M_enable_shared_from_this_with(_Yp*) noexcept
+	{ }
+
+      void*
+      _M_get_deleter(void (*__tag)()) const noexcept
+      { return _M_refcount._M_get_deleter(__tag); }
+
+      template<typename _Tp1, _Lock_policy _Lp1> friend class __shared_ptr;
+      template<typename _Tp1, _Lock_policy _Lp1> friend class __weak_ptr;
+
+      template<typename _Del, typename _Tp1, _Lock_policy _Lp1>
+	friend _Del* get_deleter(const __shared_ptr<_Tp1, _Lp1>&) noexcept;
+
+      template<typename _Del, typename _Tp1>
+	friend _Del* get_deleter(const shared_ptr<_Tp1>&) noexcept;
+
+      element_type*	   _M_ptr;         // Contained pointer.
+      __shared_count<_Lp>  _M_refcount;    // Reference counter.
+    };
+
+
+  // 20.7.2.2.7 shared_ptr comparisons, which also serve shared_ptr
+  template<typename _Tp1, typename _Tp2, _Lock_policy _Lp>
+    inline bool
+    operator==(const __shared_ptr<_Tp1, _Lp>& __a,
+	       const __shared_ptr<_Tp2, _Lp>& __b) noexcept
+    { return __a.get() == __b.get(); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator==(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    { return !__a; }
+
+#ifdef __cpp_lib_three_way_comparison
+  template<typename _Tp, typename _Up, _Lock_policy _Lp>
+    inline strong_ordering
+    operator<=>(const __shared_ptr<_Tp, _Lp>& __a,
+		const __shared_ptr<_Up, _Lp>& __b) noexcept
+    { return compare_three_way()(__a.get(), __b.get()); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline strong_ordering
+    operator<=>(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    {
+      using pointer = typename __shared_ptr<_Tp, _Lp>::element_type*;
+      return compare_three_way()(__a.get(), static_cast<pointer>(nullptr));
+    }
+#else
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator==(nullptr_t, const __shared_ptr<_Tp, _Lp>& __a) noexcept
+    { return !__a; }
+
+  template<typename _Tp1, typename _Tp2, _Lock_policy _Lp>
+    inline bool
+    operator!=(const __shared_ptr<_Tp1, _Lp>& __a,
+	       const __shared_ptr<_Tp2, _Lp>& __b) noexcept
+    { return __a.get() != __b.get(); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator!=(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    { return (bool)__a; }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator!=(nullptr_t, const __shared_ptr<_Tp, _Lp>& __a) noexcept
+    { return (bool)__a; }
+
+  template<typename _Tp, typename _Up, _Lock_policy _Lp>
+    inline bool
+    operator<(const __shared_ptr<_Tp, _Lp>& __a,
+	      const __shared_ptr<_Up, _Lp>& __b) noexcept
+    {
+      using _Tp_elt = typename __shared_ptr<_Tp, _Lp>::element_type;
+      using _Up_elt = typename __shared_ptr<_Up, _Lp>::element_type;
+      using _Vp = typename common_type<_Tp_elt*, _Up_elt*>::type;
+      return less<_Vp>()(__a.get(), __b.get());
+    }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator<(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    {
+      using _Tp_elt = typename __shared_ptr<_Tp, _Lp>::element_type;
+      return less<_Tp_elt*>()(__a.get(), nullptr);
+    }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator<(nullptr_t, const __shared_ptr<_Tp, _Lp>& __a) noexcept
+    {
+      using _Tp_elt = typename __shared_ptr<_Tp, _Lp>::element_type;
+      return less<_Tp_elt*>()(nullptr, __a.get());
+    }
+
+  template<typename _Tp1, typename _Tp2, _Lock_policy _Lp>
+    inline bool
+    operator<=(const __shared_ptr<_Tp1, _Lp>& __a,
+	       const __shared_ptr<_Tp2, _Lp>& __b) noexcept
+    { return !(__b < __a); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator<=(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    { return !(nullptr < __a); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator<=(nullptr_t, const __shared_ptr<_Tp, _Lp>& __a) noexcept
+    { return !(__a < nullptr); }
+
+  template<typename _Tp1, typename _Tp2, _Lock_policy _Lp>
+    inline bool
+    operator>(const __shared_ptr<_Tp1, _Lp>& __a,
+	      const __shared_ptr<_Tp2, _Lp>& __b) noexcept
+    { return (__b < __a); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator>(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    { return nullptr < __a; }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator>(nullptr_t, const __shared_ptr<_Tp, _Lp>& __a) noexcept
+    { return __a < nullptr; }
+
+  template<typename _Tp1, typename _Tp2, _Lock_policy _Lp>
+    inline bool
+    operator>=(const __shared_ptr<_Tp1, _Lp>& __a,
+	       const __shared_ptr<_Tp2, _Lp>& __b) noexcept
+    { return !(__a < __b); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator>=(const __shared_ptr<_Tp, _Lp>& __a, nullptr_t) noexcept
+    { return !(__a < nullptr); }
+
+  template<typename _Tp, _Lock_policy _Lp>
+    inline bool
+    operator>=(nullptr_t, const __shared_ptr<_Tp, _Lp>& __a) noexcept
+    { return !(nullptr < __a); }
+#endif // three-way comparison
+
+  // 20.7.2.2.8 shared_ptr specialized algorithms.
+  template<typename _Tp, _Lock_policy _Lp>
+    inline void
+    swap(__shared_ptr<_Tp, _Lp>& __a, __shared_ptr<_Tp, _Lp>& __b) noexcept
+    { __a.swap(__b); }
+
+  // 20.7.2.2.9 shared_ptr casts
+
+  // The seemingly equivalent code:
+  // shared_ptr<_Tp, _Lp>(static_cast<_Tp*>(__r.get()))
+  // will eventually result in undefined behaviour, attempting to
+  // delete the same object twice.
+  /// static_pointer_cast
+  template<typename _Tp, typename _Tp1, _Lock_policy _Lp>
+    inline __shared_ptr<_Tp, _Lp>
+    static_pointer_cast(const __shared_ptr<_Tp1, _Lp>& __r) noexcept
+    {
+      using _Sp = __shared_ptr<_Tp, _Lp>;
+      return _Sp(__r, static_cast<typename _Sp::element_type*>(__r.get()));
+    }
+
+  /// const_pointer_cast
+  template<typename _Tp, typename _Tp1, _Lock_policy _Lp>
+    inline __shared_ptr<_Tp, _Lp>
+    const_pointer_cast(const __shared_ptr<_Tp1, _Lp>& __r) noexcept
+    {
+      using _Sp = __shared_ptr<_Tp, _Lp>;
+      return _Sp(__r, const_cast<typename _Sp::element_type*>(__r.get()));
+    }
+
+#if __cpp_rtti
+  /// dynamic_pointer_cast
+  template<typename _Tp, typename _Tp1, _Lock_policy _Lp>
+    inline __shared_ptr<_Tp, _Lp>
+    dynamic_pointer_cast(const __shared_ptr<_Tp1, _Lp>& __r) noexcept
+    {
+      using _Sp = __shared_ptr<_Tp, _Lp>;
+      if (auto* __p = dynamic_cast<typename _Sp::element_type*>(__r.get()))
+	return _Sp(__r, __p);
+      return _Sp();
+    }
+#endif
+
+  template<typename _Tp, _Lock_policy _Lp>
+    class __weak_ptr
+    {
+      template<typename _Yp, typename _Res = void>
+	using _Compatible = typename
+	  enable_if<__sp_compatible_with<_Yp*, _Tp*>::value, _Res>::type;
+
+      // Constraint for assignment from shared_ptr and weak_ptr:
+      template<typename _Yp>
+	using _Assignable = _Compatible<_Yp, __weak_ptr&>;
+
+    public:
+      using element_type = typename remove_extent<_Tp>::type;
+
+      constexpr __weak_ptr() noexcept
+      : _M_ptr(nullptr), _M_refcount()
+      { }
+
+      __weak_ptr(const __weak_ptr&) noexcept = default;
+
+      ~__weak_ptr() = default;
+
+      // The "obvious" converting constructor implementation:
+      //
+      //  template<typename _Tp1>
+      //    __weak_ptr(const __weak_ptr<_Tp1, _Lp>& __r)
+      //    : _M_ptr(__r._M_ptr), _M_refcount(__r._M_refcount) // never throws
+      //    { }
+      //
+      // has a serious problem.
+      //
+      //  __r._M_ptr may already have been invalidated. The _M_ptr(__r._M_ptr)
+      //  conversion may require access to *__r._M_ptr (virtual inheritance).
+      //
+      // It is not possible to avoid spurious access violations since
+      // in multithreaded programs __r._M_ptr may be invalidated at any point.
+      template<typename _Yp, typename = _Compatible<_Yp>>
+	__weak_ptr(const __weak_ptr<_Yp, _Lp>& __r) noexcept
+	: _M_refcount(__r._M_refcount)
+	{ _M_ptr = __r.lock().get(); }
+
+      template<typename _Yp, typename = _Compatible<_Yp>>
+	__weak_ptr(const __shared_ptr<_Yp, _Lp>& __r) noexcept
+	: _M_ptr(__r._M_ptr), _M_refcount(__r._M_refcount)
+	{ }
+
+      __weak_ptr(__weak_ptr&& __r) noexcept
+      : _M_ptr(__r._M_ptr), _M_refcount(std::move(__r._M_refcount))
+      { __r._M_ptr = nullptr; }
+
+      template<typename _Yp, typename = _Compatible<_Yp>>
+	__weak_ptr(__weak_ptr<_Yp, _Lp>&& __r) noexcept
+	: _M_ptr(__r.lock().get()), _M_refcount(std::move(__r._M_refcount))
+	{ __r._M_ptr = nullptr; }
+
+      __weak_ptr&
+      operator=(const __weak_ptr& __r) noexcept = default;
+
+      template<typename _Yp>
+	_Assignable<_Yp>
+	operator=(const __weak_ptr<_Yp, _Lp>& __r) noexcept
+	{
+	  _M_ptr = __r.lock().get();
+	  _M_refcount = __r._M_refcount;
+	  return *this;
+	}
+
+      template<typename _Yp>
+	_Assignable<_Yp>
+	operator=(const __shared_ptr<_Yp, _Lp>& __r) noexcept
+	{
+	  _M_ptr = __r._M_ptr;
+	  _M_refcount = __r._M_refcount;
+	  return *this;
+	}
+
+      __weak_ptr&
+      operator=(__weak_ptr&& __r) noexcept
+      {
+	_M_ptr = __r._M_ptr;
+	_M_refcount = std::move(__r._M_refcount);
+	__r._M_ptr = nullptr;
+	return *this;
+      }
+
+      template<typename _Yp>
+	_Assignable<_Yp>
+	operator=(__weak_ptr<_Yp, _Lp>&& __r) noexcept
+	{
+	  _M_ptr = __r.lock().get();
+	  _M_refcount = std::move(__r._M_refcount);
+	  __r._M_ptr = nullptr;
+	  return *this;
+	}
+
+      __shared_ptr<_Tp, _Lp>
+      lock() const noexcept
+      { return __shared_ptr<_Tp, _Lp>(*this, std::nothrow); }
+
+      long
+      use_count() const noexcept
+      { return _M_refcount._M_get_use_count(); }
+
+      bool
+      expired() const noexcept
+      { return _M_refcount._M_get_use_count() == 0; }
+
+      template<typename _Tp1>
+	bool
+	owner_before(const __shared_ptr<_Tp1, _Lp>& __rhs) const noexcept
+	{ return _M_refcount._M_less(__rhs._M_refcount); }
+
+      template<typename _Tp1>
+	bool
+	owner_before(const __weak_ptr<_Tp1, _Lp>& __rhs) const noexcept
+	{ return _M_refcount._M_less(__rhs._M_refcount); }
+
+      void
+      reset() noexcept
+      { __weak_ptr().swap(*this); }
+
+      void
+      swap(__weak_ptr& __s) noexcept
+      {
+	std::swap(_M_ptr, __s._M_ptr);
+	_M_refcount._M_swap(__s._M_refcount);
+      }
+
+    private:
+      // Used by __enable_shared_from_this.
+      void
+      _M_assign(_Tp* __ptr, const __shared_count<_Lp>& __refcount) noexcept
+      {
+	if (use_count() == 0)
+	  {
+	    _M_ptr = __ptr;
+	    _M_refcount = __refcount;
+	  }
+      }
+
+      template<typename _Tp1, _Lock_policy _Lp1> friend class __shared_ptr;
+      template<typename _Tp1, _Lock_policy _Lp1> friend class __weak_ptr;
+      friend class __enable_shared_from_this<_Tp, _Lp>;
+      friend class enable_shared_from_this<_Tp>;
+
+      element_type*	 _M_ptr;         // Contained pointer.
+      __weak_count<_Lp>  _M_refcount;    // Reference counter.
+    };
+
+  // 20.7.2.3.6 weak_ptr specialized algorithms.
+  template<typename _Tp, _Lock_policy _Lp>
+    inline void
+    swap(__weak_ptr<_Tp, _Lp>& __a, __weak_ptr<_Tp, _Lp>& __b) noexcept
+    { __a.swap(__b); }
+
+  template<typename _Tp, typename _Tp1>
+    struct _Sp_owner_less : public binary_function<_Tp, _Tp, bool>
+    {
+      bool
+      operator()(const _Tp& __lhs, const _Tp& __rhs) const noexcept
+      { return __lhs.owner_before(__rhs); }
+
+      bool
+      operator()(const _Tp& __lhs, const _Tp1& __rhs) const noexcept
+      { return __lhs.owner_before(__rhs); }
+
+      bool
+      operator()(const _Tp1& __lhs, const _Tp& __rhs) const noexcept
+      { return __lhs.owner_before(__rhs); }
+    };
+
+  template<>
+    struct _Sp_owner_less<void, void>
+    {
+      template<typename _Tp, typename _Up>
+	auto
+	operator()(const _Tp& __lhs, const _Up& __rhs) const noexcept
+	-> decltype(__lhs.owner_before(__rhs))
+	{ return __lhs.owner_before(__rhs); }
+
+      using is_transparent = void;
+    };
+
+  template<typename _Tp, _Lock_policy _Lp>
+    struct owner_less<__shared_ptr<_Tp, _Lp>>
+    : public _Sp_owner_less<__shared_ptr<_Tp, _Lp>, __weak_ptr<_Tp, _Lp>>
+    { };
+
+  template<typename _Tp, _Lock_policy _Lp>
+    struct owner_less<__weak_ptr<_Tp, _Lp>>
+    : public _Sp_owner_less<__weak_ptr<_Tp, _Lp>, __shared_ptr<_Tp, _Lp>>
+    { };
+
+
+  template<typename _Tp, _Lock_policy _Lp>
+    class __enable_shared_from_this
+    {
+    protected:
+      constexpr __enable_shared_from_this() noexcept { }
+
+      __enable_shared_from_this(const __enable_shared_from_this&) noexcept { }
+
+      __enable_shared_from_this&
+      operator=(const __enable_shared_from_this&) noexcept
+      { return *this; }
+
+      ~__enable_shared_from_this() { }
+
+    public:
+      __shared_ptr<_Tp, _Lp>
+      shared_from_this()
+      { return __shared_ptr<_Tp, _Lp>(this->_M_weak_this); }
+
+      __shared_ptr<const _Tp, _Lp>
+      shared_from_this() const
+      { return __shared_ptr<const _Tp, _Lp>(this->_M_weak_this); }
+
+#if __cplusplus > 201402L || !defined(__STRICT_ANSI__) // c++1z or gnu++11
+      __weak_ptr<_Tp, _Lp>
+      weak_from_this() noexcept
+      { return this->_M_weak_this; }
+
+      __weak_ptr<const _Tp, _Lp>
+      weak_from_this() const noexcept
+      { return this->_M_weak_this; }
+#endif
+
+    private:
+      template<typename _Tp1>
+	void
+	_M_weak_assign(_Tp1* __p, const __shared_count<_Lp>& __n) const noexcept
+	{ _M_weak_this._M_assign(__p, __n); }
+
+      friend const __enable_shared_from_this*
+      __enable_shared_from_this_base(const __shared_count<_Lp>&,
+				     const __enable_shared_from_this* __p)
+      { return __p; }
+
+      template<typename, _Lock_policy>
+	friend class __shared_ptr;
+
+      mutable __weak_ptr<_Tp, _Lp>  _M_weak_this;
+    };
+
+  /// std::hash specialization for __shared_ptr.
+  template<typename _Tp, _Lock_policy _Lp>
+    struct hash<__shared_ptr<_Tp, _Lp>>
+    : public __hash_base<size_t, __shared_ptr<_Tp, _Lp>>
+    {
+      size_t
+      operator()(const __shared_ptr<_Tp, _Lp>& __s) const noexcept
+      {
+	return hash<typename __shared_ptr<_Tp, _Lp>::element_type*>()(
+	    __s.get());
+      }
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#endif // _SHARED_PTR_BASE_H
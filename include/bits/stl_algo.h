@@ -1863,11 +1863,24 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 				__gnu_cxx::__ops::__val_comp_iter(__comp));
     }
 
+#if !defined(MODM_SORT_THRESHOLD)
+#define MODM_SORT_THRESHOLD 16
+#endif
+
+#if !defined(MODM_SORT_LOW_STACK)
+#define MODM_SORT_LOW_STACK 1
+#endif
+
+#if MODM_SORT_THRESHOLD < 3
+#error "MODM_SORT_THRESHOLD must be at least 3"
+#endif
+
   /**
-   *  @doctodo
-   *  This controls some aspect of the sort routines.
+   *  Ranges of at most this many elements are left to the final insertion
+   *  sort by std::sort.  Define MODM_SORT_THRESHOLD to trade the cost of
+   *  partitioning against that of insertion sort on a target.
   */
-  enum { _S_threshold = 16 };
+  enum { _S_threshold = MODM_SORT_THRESHOLD };
 
   /// This is a helper function for the sort routine.
   template<typename _RandomAccessIterator, typename _Compare>
@@ -1934,6 +1947,11 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     }
 
   /// This is a helper function for the sort routine.
+  // With MODM_SORT_LOW_STACK (the default), it recurses into the smaller
+  // partition and iterates on the larger one, so the recursion depth is
+  // at most log2(n) regardless of the pivots.  Otherwise it always
+  // recurses into the right partition, as upstream, and the depth is
+  // only bounded by the depth limit of 2*log2(n).
   template<typename _RandomAccessIterator, typename _Size, typename _Compare>
     _GLIBCXX20_CONSTEXPR
     void
@@ -1951,6 +1969,14 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	  --__depth_limit;
 	  _RandomAccessIterator __cut =
 	    std::__unguarded_partition_pivot(__first, __last, __comp);
+#if MODM_SORT_LOW_STACK
+	  if (__cut - __first < __last - __cut)
+	    {
+	      std::__introsort_loop(__first, __cut, __depth_limit, __comp);
+	      __first = __cut;
+	      continue;
+	    }
+#endif
 	  std::__introsort_loop(__cut, __last, __depth_limit, __comp);
 	  __last = __cut;
 	}
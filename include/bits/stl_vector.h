@@ -1756,7 +1756,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       _M_check_len(size_type __n, const char* __s) const
       {
 	if (max_size() - size() < __n)
-	  __throw_length_error(__N(__s));
+	  __throw_length_error(__s);
 
 	const size_type __len = size() + (std::max)(size(), __n);
 	return (__len < size() || __len > max_size()) ? max_size() : __len;
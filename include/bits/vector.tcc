@@ -433,7 +433,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 #endif
     {
       const size_type __len =
-	_M_check_len(size_type(1), "vector::_M_realloc_insert");
+	_M_check_len(size_type(1), __N("vector::_M_realloc_insert"));
       pointer __old_start = this->_M_impl._M_start;
       pointer __old_finish = this->_M_impl._M_finish;
       const size_type __elems_before = __position - begin();
@@ -556,7 +556,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	  else
 	    {
 	      const size_type __len =
-		_M_check_len(__n, "vector::_M_fill_insert");
+		_M_check_len(__n, __N("vector::_M_fill_insert"));
 	      const size_type __elems_before = __position - begin();
 	      pointer __new_start(this->_M_allocate(__len));
 	      pointer __new_finish(__new_start);
@@ -631,7 +631,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	  else
 	    {
 	      const size_type __len =
-		_M_check_len(__n, "vector::_M_default_append");
+		_M_check_len(__n, __N("vector::_M_default_append"));
 	      pointer __new_start(this->_M_allocate(__len));
 	      if _GLIBCXX17_CONSTEXPR (_S_use_relocate())
 		{
@@ -765,7 +765,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	    else
 	      {
 		const size_type __len =
-		  _M_check_len(__n, "vector::_M_range_insert");
+		  _M_check_len(__n, __N("vector::_M_range_insert"));
 		pointer __new_start(this->_M_allocate(__len));
 		pointer __new_finish(__new_start);
 		__try
@@ -836,7 +836,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       else
 	{
 	  const size_type __len = 
-	    _M_check_len(__n, "vector<bool>::_M_fill_insert");
+	    _M_check_len(__n, __N("vector<bool>::_M_fill_insert"));
 	  _Bit_pointer __q = this->_M_allocate(__len);
 	  iterator __start(std::__addressof(*__q), 0);
 	  iterator __i = _M_copy_aligned(begin(), __position, __start);
@@ -871,7 +871,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	    else
 	      {
 		const size_type __len =
-		  _M_check_len(__n, "vector<bool>::_M_insert_range");
+		  _M_check_len(__n, __N("vector<bool>::_M_insert_range"));
 		_Bit_pointer __q = this->_M_allocate(__len);
 		iterator __start(std::__addressof(*__q), 0);
 		iterator __i = _M_copy_aligned(begin(), __position, __start);
@@ -900,7 +900,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       else
 	{
 	  const size_type __len =
-	    _M_check_len(size_type(1), "vector<bool>::_M_insert_aux");
+	    _M_check_len(size_type(1), __N("vector<bool>::_M_insert_aux"));
 	  _Bit_pointer __q = this->_M_allocate(__len);
 	  iterator __start(std::__addressof(*__q), 0);
 	  iterator __i = _M_copy_aligned(begin(), __position, __start);
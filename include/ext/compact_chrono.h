@@ -0,0 +1,212 @@
+// Compact durations and wrapping time points -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/compact_chrono.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Durations with 16-bit and 32-bit representations, and time points
+ *  that wrap around and compare modulo their width.  The standard
+ *  typedefs such as std::chrono::milliseconds use 64-bit reps, which
+ *  makes every stored timestamp 8 bytes and every comparison multi-word
+ *  arithmetic on 8-bit targets.
+ *
+ *  The durations are plain std::chrono::duration specializations, so
+ *  common_type, duration_cast and mixed arithmetic with the standard
+ *  typedefs work as usual; conversions between compact durations use
+ *  16 or 32-bit intermediates where that is exact.
+ */
+
+#ifndef _COMPACT_CHRONO_H
+#define _COMPACT_CHRONO_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace chrono
+{
+  using us16 = std::chrono::duration<std::int16_t, std::micro>;
+  using us32 = std::chrono::duration<std::int32_t, std::micro>;
+  using ms16 = std::chrono::duration<std::int16_t, std::milli>;
+  using ms32 = std::chrono::duration<std::int32_t, std::milli>;
+  using s16  = std::chrono::duration<std::int16_t>;
+  using s32  = std::chrono::duration<std::int32_t>;
+
+  /**
+   *  @brief  A time point of @a _Clock truncated to the width of a
+   *  compact duration.
+   *
+   *  The stored value wraps around.  The difference of two time points
+   *  is the signed distance modulo the width, and a time point compares
+   *  less than another if that distance is negative.  This is correct
+   *  as long as the compared time points are less than half the range
+   *  of @a _Dur apart (about 32s for ms16 and 35min for us32).
+   */
+  template<typename _Clock, typename _Dur>
+    class wrapping_time_point
+    {
+      static_assert(std::chrono::__is_duration<_Dur>::value,
+		    "duration must be a specialization of std::chrono::duration");
+      static_assert(std::is_integral<typename _Dur::rep>::value
+		    && std::is_signed<typename _Dur::rep>::value,
+		    "duration must have a signed integral rep");
+
+      using __urep = typename std::make_unsigned<typename _Dur::rep>::type;
+
+      __urep _M_t;
+
+      constexpr explicit
+      wrapping_time_point(__urep __t, int) noexcept
+      : _M_t(__t)
+      { }
+
+    public:
+      typedef _Clock				clock;
+      typedef _Dur				duration;
+      typedef typename duration::rep		rep;
+      typedef typename duration::period		period;
+
+      constexpr
+      wrapping_time_point() noexcept
+      : _M_t(0)
+      { }
+
+      /// Truncate a full-width time point of the same clock.
+      template<typename _Dur2>
+	constexpr explicit
+	wrapping_time_point(const std::chrono::time_point<_Clock, _Dur2>& __t)
+	noexcept
+	: _M_t(static_cast<__urep>(std::chrono::duration_cast<
+	    std::chrono::duration<typename _Dur2::rep, period>>(
+	      __t.time_since_epoch()).count()))
+	{ }
+
+      static wrapping_time_point
+      now() noexcept
+      { return wrapping_time_point(_Clock::now()); }
+
+      /// The time since the epoch, modulo the width of the rep.
+      constexpr duration
+      time_since_epoch() const noexcept
+      { return duration(static_cast<rep>(_M_t)); }
+
+      _GLIBCXX17_CONSTEXPR wrapping_time_point&
+      operator+=(const duration& __d) noexcept
+      {
+	_M_t = static_cast<__urep>(_M_t + static_cast<__urep>(__d.count()));
+	return *this;
+      }
+
+      _GLIBCXX17_CONSTEXPR wrapping_time_point&
+      operator-=(const duration& __d) noexcept
+      {
+	_M_t = static_cast<__urep>(_M_t - static_cast<__urep>(__d.count()));
+	return *this;
+      }
+
+      friend constexpr wrapping_time_point
+      operator+(const wrapping_time_point& __t, const duration& __d) noexcept
+      {
+	return wrapping_time_point(
+	    static_cast<__urep>(__t._M_t + static_cast<__urep>(__d.count())), 0);
+      }
+
+      friend constexpr wrapping_time_point
+      operator+(const duration& __d, const wrapping_time_point& __t) noexcept
+      { return __t + __d; }
+
+      friend constexpr wrapping_time_point
+      operator-(const wrapping_time_point& __t, const duration& __d) noexcept
+      {
+	return wrapping_time_point(
+	    static_cast<__urep>(__t._M_t - static_cast<__urep>(__d.count())), 0);
+      }
+
+      /// The signed distance from @a __rhs to @a __lhs, modulo the width.
+      friend constexpr duration
+      operator-(const wrapping_time_point& __lhs,
+		const wrapping_time_point& __rhs) noexcept
+      {
+	return duration(static_cast<rep>(
+	    static_cast<__urep>(__lhs._M_t - __rhs._M_t)));
+      }
+
+      friend constexpr bool
+      operator==(const wrapping_time_point& __lhs,
+		 const wrapping_time_point& __rhs) noexcept
+      { return __lhs._M_t == __rhs._M_t; }
+
+      friend constexpr bool
+      operator!=(const wrapping_time_point& __lhs,
+		 const wrapping_time_point& __rhs) noexcept
+      { return !(__lhs == __rhs); }
+
+      friend constexpr bool
+      operator<(const wrapping_time_point& __lhs,
+		const wrapping_time_point& __rhs) noexcept
+      { return (__lhs - __rhs).count() < 0; }
+
+      friend constexpr bool
+      operator>(const wrapping_time_point& __lhs,
+		const wrapping_time_point& __rhs) noexcept
+      { return __rhs < __lhs; }
+
+      friend constexpr bool
+      operator<=(const wrapping_time_point& __lhs,
+		 const wrapping_time_point& __rhs) noexcept
+      { return !(__rhs < __lhs); }
+
+      friend constexpr bool
+      operator>=(const wrapping_time_point& __lhs,
+		 const wrapping_time_point& __rhs) noexcept
+      { return !(__lhs < __rhs); }
+    };
+
+  template<typename _Clock = std::chrono::steady_clock>
+    using us16_point = wrapping_time_point<_Clock, us16>;
+
+  template<typename _Clock = std::chrono::steady_clock>
+    using us32_point = wrapping_time_point<_Clock, us32>;
+
+  template<typename _Clock = std::chrono::steady_clock>
+    using ms16_point = wrapping_time_point<_Clock, ms16>;
+
+  template<typename _Clock = std::chrono::steady_clock>
+    using ms32_point = wrapping_time_point<_Clock, ms32>;
+} // namespace chrono
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++11
+
+#endif // _COMPACT_CHRONO_H
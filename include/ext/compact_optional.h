@@ -0,0 +1,549 @@
+// Optional values without a separate flag -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/compact_optional.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  An optional value that is as large as the value itself.
+ *
+ *  A std::optional<_Tp> stores a flag after the value, so a
+ *  std::optional<std::uint8_t> takes 2 bytes and a
+ *  std::optional<std::uint16_t> 3 bytes.  If some value of _Tp is never
+ *  used, __gnu_cxx::compact_optional<_Tp, _Niche> stores that value, the
+ *  sentinel, to mean "no value" instead, and has_value() is a comparison
+ *  with it.  _Niche::niche is the sentinel, by default the one named by
+ *  __gnu_cxx::niche_traits<_Tp>; __gnu_cxx::niche_value<_V> names a
+ *  sentinel in place:
+ *
+ *  @code
+ *  // Readings of an 8-bit ADC, of which 0xff means "out of range".
+ *  __gnu_cxx::compact_optional<std::uint8_t, __gnu_cxx::niche_value<0xff>>
+ *    __readings[16];                       // 16 bytes
+ *
+ *  // A pointer that may be null.
+ *  __gnu_cxx::compact_optional<sensor*, __gnu_cxx::niche_value<nullptr>>
+ *    __active;
+ *  @endcode
+ *
+ *  The interface is that of std::optional.  _Tp must be trivially
+ *  copyable and equality comparable, and so is the compact_optional;
+ *  storing the sentinel as a value is undefined, and caught by
+ *  _GLIBCXX_ASSERTIONS.
+ */
+
+#ifndef _COMPACT_OPTIONAL_H
+#define _COMPACT_OPTIONAL_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <optional>
+#include <bits/niche_traits.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Names @a _V, converted to the value type, as the sentinel of a
+  /// compact_optional.
+  template<auto _V>
+    struct niche_value
+    {
+      static constexpr auto niche = _V;
+    };
+
+  /**
+   *  @brief An optional value of type @a _Tp that stores _Niche::niche
+   *  when it holds no value.
+   */
+  template<typename _Tp, typename _Niche = niche_traits<_Tp>>
+    class compact_optional
+    {
+      static_assert(std::is_trivially_copyable_v<_Tp>,
+		    "compact_optional requires a trivially copyable type");
+      static_assert(!std::is_reference_v<_Tp>);
+      static_assert(!std::is_same_v<std::remove_cv_t<_Tp>, std::nullopt_t>);
+      static_assert(!std::is_same_v<std::remove_cv_t<_Tp>, std::in_place_t>);
+
+      static constexpr _Tp
+      _S_sentinel() noexcept
+      { return static_cast<_Tp>(_Niche::niche); }
+
+      template<typename _Up>
+	using __not_self = std::__not_<std::is_same<compact_optional,
+						    std::__remove_cvref_t<_Up>>>;
+      template<typename _Up>
+	using __not_tag = std::__not_<std::is_same<std::in_place_t,
+						   std::__remove_cvref_t<_Up>>>;
+      template<typename... _Cond>
+	using _Requires = std::enable_if_t<std::__and_v<_Cond...>, bool>;
+
+    public:
+      using value_type = _Tp;
+
+      constexpr
+      compact_optional() noexcept
+      : _M_val(_S_sentinel()) { }
+
+      constexpr
+      compact_optional(std::nullopt_t) noexcept
+      : _M_val(_S_sentinel()) { }
+
+      template<typename _Up = _Tp,
+	       _Requires<__not_self<_Up>, __not_tag<_Up>,
+			 std::is_constructible<_Tp, _Up&&>,
+			 std::is_convertible<_Up&&, _Tp>> = true>
+	constexpr
+	compact_optional(_Up&& __v)
+	: _M_val(std::forward<_Up>(__v))
+	{ __glibcxx_assert(has_value()); }
+
+      template<typename _Up = _Tp,
+	       _Requires<__not_self<_Up>, __not_tag<_Up>,
+			 std::is_constructible<_Tp, _Up&&>,
+			 std::__not_<std::is_convertible<_Up&&, _Tp>>> = false>
+	explicit constexpr
+	compact_optional(_Up&& __v)
+	: _M_val(std::forward<_Up>(__v))
+	{ __glibcxx_assert(has_value()); }
+
+      template<typename... _Args,
+	       _Requires<std::is_constructible<_Tp, _Args&&...>> = false>
+	explicit constexpr
+	compact_optional(std::in_place_t, _Args&&... __args)
+	: _M_val(std::forward<_Args>(__args)...)
+	{ __glibcxx_assert(has_value()); }
+
+      /// Converts a std::optional, e.g. one returned by a library function.
+      constexpr
+      compact_optional(const std::optional<_Tp>& __o) noexcept
+      : _M_val(__o ? *__o : _S_sentinel())
+      { __glibcxx_assert(!__o || has_value()); }
+
+      constexpr compact_optional&
+      operator=(std::nullopt_t) noexcept
+      {
+	_M_val = _S_sentinel();
+	return *this;
+      }
+
+      template<typename _Up = _Tp>
+	constexpr
+	std::enable_if_t<std::__and_v<__not_self<_Up>,
+				      std::is_constructible<_Tp, _Up>,
+				      std::is_assignable<_Tp&, _Up>>,
+			 compact_optional&>
+	operator=(_Up&& __v)
+	{
+	  _M_val = std::forward<_Up>(__v);
+	  __glibcxx_assert(has_value());
+	  return *this;
+	}
+
+      template<typename... _Args>
+	constexpr
+	std::enable_if_t<std::is_constructible_v<_Tp, _Args&&...>, _Tp&>
+	emplace(_Args&&... __args)
+	{
+	  _M_val = _Tp(std::forward<_Args>(__args)...);
+	  __glibcxx_assert(has_value());
+	  return _M_val;
+	}
+
+      constexpr void
+      swap(compact_optional& __other) noexcept
+      {
+	_Tp __tmp = _M_val;
+	_M_val = __other._M_val;
+	__other._M_val = __tmp;
+      }
+
+      constexpr void
+      reset() noexcept
+      { _M_val = _S_sentinel(); }
+
+      // Observers.
+
+      constexpr const _Tp*
+      operator->() const noexcept
+      {
+	__glibcxx_assert(has_value());
+	return std::__addressof(_M_val);
+      }
+
+      constexpr _Tp*
+      operator->() noexcept
+      {
+	__glibcxx_assert(has_value());
+	return std::__addressof(_M_val);
+      }
+
+      constexpr const _Tp&
+      operator*() const& noexcept
+      {
+	__glibcxx_assert(has_value());
+	return _M_val;
+      }
+
+      constexpr _Tp&
+      operator*() & noexcept
+      {
+	__glibcxx_assert(has_value());
+	return _M_val;
+      }
+
+      constexpr _Tp&&
+      operator*() && noexcept
+      {
+	__glibcxx_assert(has_value());
+	return std::move(_M_val);
+      }
+
+      constexpr const _Tp&&
+      operator*() const&& noexcept
+      {
+	__glibcxx_assert(has_value());
+	return std::move(_M_val);
+      }
+
+      constexpr explicit
+      operator bool() const noexcept
+      { return has_value(); }
+
+      constexpr bool
+      has_value() const noexcept
+      { return !static_cast<bool>(_M_val == _S_sentinel()); }
+
+      constexpr const _Tp&
+      value() const&
+      {
+	if (!has_value())
+	  std::__throw_bad_optional_access();
+	return _M_val;
+      }
+
+      constexpr _Tp&
+      value() &
+      {
+	if (!has_value())
+	  std::__throw_bad_optional_access();
+	return _M_val;
+      }
+
+      constexpr _Tp&&
+      value() &&
+      {
+	if (!has_value())
+	  std::__throw_bad_optional_access();
+	return std::move(_M_val);
+      }
+
+      constexpr const _Tp&&
+      value() const&&
+      {
+	if (!has_value())
+	  std::__throw_bad_optional_access();
+	return std::move(_M_val);
+      }
+
+      template<typename _Up>
+	constexpr _Tp
+	value_or(_Up&& __u) const
+	{
+	  static_assert(std::is_convertible_v<_Up&&, _Tp>);
+
+	  return has_value() ? _M_val
+			     : static_cast<_Tp>(std::forward<_Up>(__u));
+	}
+
+      /// The same value as a std::optional, which takes one more byte.
+      constexpr std::optional<_Tp>
+      to_optional() const noexcept
+      {
+	if (has_value())
+	  return _M_val;
+	return std::nullopt;
+      }
+
+    private:
+      _Tp _M_val;
+    };
+
+  template<typename _Tp>
+    inline constexpr bool __is_compact_optional = false;
+
+  template<typename _Tp, typename _Niche>
+    inline constexpr bool
+    __is_compact_optional<compact_optional<_Tp, _Niche>> = true;
+
+  // Comparisons, with the meaning they have for std::optional.
+
+  template<typename _Tp, typename _Np, typename _Up, typename _Mp>
+    constexpr auto
+    operator==(const compact_optional<_Tp, _Np>& __x,
+	       const compact_optional<_Up, _Mp>& __y)
+    -> decltype(__x.to_optional() == __y.to_optional())
+    { return __x.to_optional() == __y.to_optional(); }
+
+  template<typename _Tp, typename _Np, typename _Up, typename _Mp>
+    constexpr auto
+    operator!=(const compact_optional<_Tp, _Np>& __x,
+	       const compact_optional<_Up, _Mp>& __y)
+    -> decltype(__x.to_optional() != __y.to_optional())
+    { return __x.to_optional() != __y.to_optional(); }
+
+  template<typename _Tp, typename _Np, typename _Up, typename _Mp>
+    constexpr auto
+    operator<(const compact_optional<_Tp, _Np>& __x,
+	      const compact_optional<_Up, _Mp>& __y)
+    -> decltype(__x.to_optional() < __y.to_optional())
+    { return __x.to_optional() < __y.to_optional(); }
+
+  template<typename _Tp, typename _Np, typename _Up, typename _Mp>
+    constexpr auto
+    operator>(const compact_optional<_Tp, _Np>& __x,
+	      const compact_optional<_Up, _Mp>& __y)
+    -> decltype(__x.to_optional() > __y.to_optional())
+    { return __x.to_optional() > __y.to_optional(); }
+
+  template<typename _Tp, typename _Np, typename _Up, typename _Mp>
+    constexpr auto
+    operator<=(const compact_optional<_Tp, _Np>& __x,
+	       const compact_optional<_Up, _Mp>& __y)
+    -> decltype(__x.to_optional() <= __y.to_optional())
+    { return __x.to_optional() <= __y.to_optional(); }
+
+  template<typename _Tp, typename _Np, typename _Up, typename _Mp>
+    constexpr auto
+    operator>=(const compact_optional<_Tp, _Np>& __x,
+	       const compact_optional<_Up, _Mp>& __y)
+    -> decltype(__x.to_optional() >= __y.to_optional())
+    { return __x.to_optional() >= __y.to_optional(); }
+
+  // Comparisons with std::optional, preferred to those with values.
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator==(const compact_optional<_Tp, _Np>& __x,
+	       const std::optional<_Up>& __y)
+    -> decltype(__x.to_optional() == __y)
+    { return __x.to_optional() == __y; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator!=(const compact_optional<_Tp, _Np>& __x,
+	       const std::optional<_Up>& __y)
+    -> decltype(__x.to_optional() != __y)
+    { return __x.to_optional() != __y; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator<(const compact_optional<_Tp, _Np>& __x,
+	      const std::optional<_Up>& __y)
+    -> decltype(__x.to_optional() < __y)
+    { return __x.to_optional() < __y; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator>(const compact_optional<_Tp, _Np>& __x,
+	      const std::optional<_Up>& __y)
+    -> decltype(__x.to_optional() > __y)
+    { return __x.to_optional() > __y; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator<=(const compact_optional<_Tp, _Np>& __x,
+	       const std::optional<_Up>& __y)
+    -> decltype(__x.to_optional() <= __y)
+    { return __x.to_optional() <= __y; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator>=(const compact_optional<_Tp, _Np>& __x,
+	       const std::optional<_Up>& __y)
+    -> decltype(__x.to_optional() >= __y)
+    { return __x.to_optional() >= __y; }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator==(const std::optional<_Up>& __y,
+	       const compact_optional<_Tp, _Np>& __x)
+    -> decltype(__y == __x.to_optional())
+    { return __y == __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator!=(const std::optional<_Up>& __y,
+	       const compact_optional<_Tp, _Np>& __x)
+    -> decltype(__y != __x.to_optional())
+    { return __y != __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator<(const std::optional<_Up>& __y,
+	      const compact_optional<_Tp, _Np>& __x)
+    -> decltype(__y < __x.to_optional())
+    { return __y < __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator>(const std::optional<_Up>& __y,
+	      const compact_optional<_Tp, _Np>& __x)
+    -> decltype(__y > __x.to_optional())
+    { return __y > __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator<=(const std::optional<_Up>& __y,
+	       const compact_optional<_Tp, _Np>& __x)
+    -> decltype(__y <= __x.to_optional())
+    { return __y <= __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator>=(const std::optional<_Up>& __y,
+	       const compact_optional<_Tp, _Np>& __x)
+    -> decltype(__y >= __x.to_optional())
+    { return __y >= __x.to_optional(); }
+
+  // Comparisons with std::nullopt and with values.
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator==(const compact_optional<_Tp, _Np>& __x, const _Up& __v)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__x.to_optional() == __v)>
+    { return __x.to_optional() == __v; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator!=(const compact_optional<_Tp, _Np>& __x, const _Up& __v)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__x.to_optional() != __v)>
+    { return __x.to_optional() != __v; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator<(const compact_optional<_Tp, _Np>& __x, const _Up& __v)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__x.to_optional() < __v)>
+    { return __x.to_optional() < __v; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator>(const compact_optional<_Tp, _Np>& __x, const _Up& __v)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__x.to_optional() > __v)>
+    { return __x.to_optional() > __v; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator<=(const compact_optional<_Tp, _Np>& __x, const _Up& __v)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__x.to_optional() <= __v)>
+    { return __x.to_optional() <= __v; }
+
+  template<typename _Tp, typename _Np, typename _Up>
+    constexpr auto
+    operator>=(const compact_optional<_Tp, _Np>& __x, const _Up& __v)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__x.to_optional() >= __v)>
+    { return __x.to_optional() >= __v; }
+
+#if __cpp_impl_three_way_comparison < 201907L
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator==(const _Up& __v, const compact_optional<_Tp, _Np>& __x)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__v == __x.to_optional())>
+    { return __v == __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator!=(const _Up& __v, const compact_optional<_Tp, _Np>& __x)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__v != __x.to_optional())>
+    { return __v != __x.to_optional(); }
+#endif
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator<(const _Up& __v, const compact_optional<_Tp, _Np>& __x)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__v < __x.to_optional())>
+    { return __v < __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator>(const _Up& __v, const compact_optional<_Tp, _Np>& __x)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__v > __x.to_optional())>
+    { return __v > __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator<=(const _Up& __v, const compact_optional<_Tp, _Np>& __x)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__v <= __x.to_optional())>
+    { return __v <= __x.to_optional(); }
+
+  template<typename _Up, typename _Tp, typename _Np>
+    constexpr auto
+    operator>=(const _Up& __v, const compact_optional<_Tp, _Np>& __x)
+    -> std::enable_if_t<!__is_compact_optional<_Up>,
+			decltype(__v >= __x.to_optional())>
+    { return __v >= __x.to_optional(); }
+
+  template<typename _Tp, typename _Np>
+    constexpr void
+    swap(compact_optional<_Tp, _Np>& __x,
+	 compact_optional<_Tp, _Np>& __y) noexcept
+    { __x.swap(__y); }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// std::hash specialization for __gnu_cxx::compact_optional, hashing
+  /// like the std::optional holding the same value.
+  template<typename _Tp, typename _Np>
+    struct hash<__gnu_cxx::compact_optional<_Tp, _Np>>
+    : public hash<optional<_Tp>>
+    {
+      size_t
+      operator()(const __gnu_cxx::compact_optional<_Tp, _Np>& __x) const
+      noexcept(noexcept(hash<optional<_Tp>>{}(__x.to_optional())))
+      { return hash<optional<_Tp>>::operator()(__x.to_optional()); }
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++17
+
+#endif // _COMPACT_OPTIONAL_H
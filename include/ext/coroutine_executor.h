@@ -0,0 +1,611 @@
+// Cooperative coroutine executor -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/coroutine_executor.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  A single-threaded, cooperative executor for C++20 coroutines.
+ *  Coroutine frames are taken from a statically sized pool instead of
+ *  the heap, so the memory used by a set of concurrent state machines
+ *  is fixed at link time.
+ *
+ *  @code
+ *  __gnu_cxx::coroutine_executor __ex;
+ *  __gnu_cxx::coroutine_event __rx_ready;  // set() from an ISR
+ *
+ *  __gnu_cxx::task<> blink()
+ *  {
+ *    for (;;)
+ *      {
+ *        PINB = (1U << PORTB5);
+ *        co_await __gnu_cxx::sleep_for(std::chrono::milliseconds(500));
+ *      }
+ *  }
+ *
+ *  int main()
+ *  {
+ *    __ex.spawn(blink());
+ *    __ex.run();
+ *  }
+ *  @endcode
+ */
+
+#ifndef _COROUTINE_EXECUTOR_H
+#define _COROUTINE_EXECUTOR_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus > 201703L
+
+#include <coroutine>
+
+#if __cpp_impl_coroutine
+
+#include <chrono>
+#include <bits/functexcept.h>
+#include <bits/move.h>
+#include <new>
+#include <ext/aligned_buffer.h>
+
+// Size in bytes of one coroutine frame slot in the default frame pool.
+#if !defined(MODM_COROUTINE_FRAME_SIZE)
+#define MODM_COROUTINE_FRAME_SIZE 64
+#endif
+
+// Number of coroutine frame slots in the default frame pool.
+#if !defined(MODM_COROUTINE_FRAME_COUNT)
+#define MODM_COROUTINE_FRAME_COUNT 8
+#endif
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief  A fixed pool of equally sized coroutine frame slots.
+   *
+   *  Slots are handed out from a bump index until the pool has been used
+   *  up once, and from a free list afterwards.  All state is
+   *  zero-initialized, so the pool lives in .bss and needs no constructor.
+   *  Requesting a frame larger than @a _BlockSize, or more than
+   *  @a _NumBlocks frames at once, calls std::__throw_bad_alloc().
+   */
+  template<std::size_t _BlockSize, std::size_t _NumBlocks>
+    class frame_pool
+    {
+      union _Block
+      {
+	_Block* _M_next;
+	alignas(__BIGGEST_ALIGNMENT__) unsigned char _M_data[_BlockSize];
+      };
+
+      static inline _Block	 _S_blocks[_NumBlocks];
+      static inline _Block*	 _S_free;
+      static inline std::size_t _S_used;
+
+    public:
+      static constexpr std::size_t block_size = _BlockSize;
+      static constexpr std::size_t block_count = _NumBlocks;
+
+      static void*
+      allocate(std::size_t __n)
+      {
+	if (__n > _BlockSize)
+	  std::__throw_bad_alloc();
+
+	_Block* __b = _S_free;
+	if (__b)
+	  _S_free = __b->_M_next;
+	else if (_S_used < _NumBlocks)
+	  __b = &_S_blocks[_S_used++];
+	else
+	  std::__throw_bad_alloc();
+	return static_cast<void*>(__b);
+      }
+
+      static void
+      deallocate(void* __p, std::size_t) noexcept
+      {
+	_Block* __b = static_cast<_Block*>(__p);
+	__b->_M_next = _S_free;
+	_S_free = __b;
+      }
+    };
+
+  /// The pool used by task<> unless another one is named.
+  using default_frame_pool = frame_pool<MODM_COROUTINE_FRAME_SIZE,
+					MODM_COROUTINE_FRAME_COUNT>;
+
+  class coroutine_executor;
+
+  template<typename _Tp = void, typename _Pool = default_frame_pool>
+    class task;
+
+  /// @cond undocumented
+
+  // A suspended coroutine waiting to be resumed by the executor.  Nodes
+  // live inside coroutine frames (in promises and awaiters), so neither
+  // the ready queue nor the wait list ever allocates.
+  struct __coro_node
+  {
+    __coro_node*	    _M_next = nullptr;
+    std::coroutine_handle<> _M_handle;
+    // Returns true once the coroutine may be resumed.  A null predicate
+    // means the node is ready as soon as it is queued.
+    bool (*_M_poll)(__coro_node*) = nullptr;
+  };
+
+  struct __task_promise_base
+  {
+    __coro_node		    _M_node;
+    std::coroutine_handle<> _M_continuation;
+    coroutine_executor*	    _M_executor = nullptr;
+    bool		    _M_detached = false;
+
+    struct _Final_awaiter
+    {
+      bool
+      await_ready() const noexcept
+      { return false; }
+
+      template<typename _Promise>
+	std::coroutine_handle<>
+	await_suspend(std::coroutine_handle<_Promise> __h) noexcept;
+
+      void
+      await_resume() const noexcept
+      { }
+    };
+
+    std::suspend_always
+    initial_suspend() const noexcept
+    { return { }; }
+
+    _Final_awaiter
+    final_suspend() const noexcept
+    { return { }; }
+
+    void
+    unhandled_exception() const noexcept
+    { __builtin_abort(); }
+  };
+
+  template<typename _Tp>
+    struct __task_promise_value : __task_promise_base
+    {
+      __aligned_membuf<_Tp> _M_value;
+      bool		    _M_has_value = false;
+
+      // The result of a task that is destroyed before it is awaited.
+      ~__task_promise_value()
+      {
+	if (_M_has_value)
+	  _M_value._M_ptr()->~_Tp();
+      }
+
+      template<typename _Up>
+	void
+	return_value(_Up&& __u)
+	{
+	  ::new (_M_value._M_addr()) _Tp(std::forward<_Up>(__u));
+	  _M_has_value = true;
+	}
+
+      _Tp
+      _M_take()
+      {
+	_Tp __r(std::move(*_M_value._M_ptr()));
+	_M_value._M_ptr()->~_Tp();
+	_M_has_value = false;
+	return __r;
+      }
+    };
+
+  template<>
+    struct __task_promise_value<void> : __task_promise_base
+    {
+      void
+      return_void() const noexcept
+      { }
+
+      void
+      _M_take() const noexcept
+      { }
+    };
+
+  /// @endcond
+
+  /**
+   *  @brief  Runs coroutines cooperatively from a single thread.
+   *
+   *  The executor keeps an intrusive ready queue and an intrusive list of
+   *  coroutines suspended on timers or events.  run_once() polls the wait
+   *  list and resumes everything that became ready; it never blocks, so it
+   *  can be called from a main loop that also sleeps the CPU when idle.
+   *  Only coroutine_event::set() may be called from interrupt context.
+   */
+  class coroutine_executor
+  {
+    __coro_node* _M_ready_head = nullptr;
+    __coro_node* _M_ready_tail = nullptr;
+    __coro_node* _M_waiting = nullptr;
+    std::size_t	 _M_tasks = 0;
+
+    template<typename, typename>
+      friend class task;
+    friend struct __task_promise_base;
+    friend struct __coro_wait_base;
+
+    void
+    _M_push_ready(__coro_node* __n) noexcept
+    {
+      __n->_M_next = nullptr;
+      if (_M_ready_tail)
+	_M_ready_tail->_M_next = __n;
+      else
+	_M_ready_head = __n;
+      _M_ready_tail = __n;
+    }
+
+    void
+    _M_push_waiting(__coro_node* __n) noexcept
+    {
+      __n->_M_next = _M_waiting;
+      _M_waiting = __n;
+    }
+
+    void
+    _M_poll_waiting() noexcept
+    {
+      __coro_node** __link = &_M_waiting;
+      while (__coro_node* __n = *__link)
+	{
+	  if (__n->_M_poll(__n))
+	    {
+	      *__link = __n->_M_next;
+	      _M_push_ready(__n);
+	    }
+	  else
+	    __link = &__n->_M_next;
+	}
+    }
+
+    void
+    _M_task_done() noexcept
+    { --_M_tasks; }
+
+  public:
+    coroutine_executor() = default;
+    coroutine_executor(const coroutine_executor&) = delete;
+    coroutine_executor& operator=(const coroutine_executor&) = delete;
+
+    /// Take ownership of @a __t and schedule it to start running.
+    template<typename _Tp, typename _Pool>
+      void
+      spawn(task<_Tp, _Pool>&& __t) noexcept
+      {
+	auto __h = std::__exchange(__t._M_handle, nullptr);
+	auto& __p = __h.promise();
+	__p._M_executor = this;
+	__p._M_detached = true;
+	__p._M_node._M_handle = __h;
+	++_M_tasks;
+	_M_push_ready(&__p._M_node);
+      }
+
+    /// Resume every coroutine that is ready now.
+    /// @return True if at least one coroutine was resumed.
+    bool
+    run_once()
+    {
+      _M_poll_waiting();
+
+      // Only drain what is queued now, coroutines readied while resuming
+      // are handled by the next call so that timers are polled in between.
+      __coro_node* __n = std::__exchange(_M_ready_head, nullptr);
+      _M_ready_tail = nullptr;
+      const bool __progress = __n != nullptr;
+      while (__n)
+	{
+	  __coro_node* __next = __n->_M_next;
+	  __n->_M_handle.resume();
+	  __n = __next;
+	}
+      return __progress;
+    }
+
+    /// Run until every spawned task has completed.
+    void
+    run()
+    {
+      while (_M_tasks != 0)
+	run_once();
+    }
+
+    /// Number of spawned tasks that have not completed yet.
+    std::size_t
+    pending() const noexcept
+    { return _M_tasks; }
+  };
+
+  /// @cond undocumented
+
+  template<typename _Promise>
+    std::coroutine_handle<>
+    __task_promise_base::_Final_awaiter::
+    await_suspend(std::coroutine_handle<_Promise> __h) noexcept
+    {
+      __task_promise_base& __p = __h.promise();
+      if (__p._M_continuation)
+	return __p._M_continuation;
+      if (__p._M_detached)
+	{
+	  __p._M_executor->_M_task_done();
+	  __h.destroy();
+	}
+      return std::noop_coroutine();
+    }
+
+  // Common part of the awaiters that park a task on the wait list.
+  struct __coro_wait_base
+  {
+    __coro_node _M_node;
+
+    template<typename _Promise>
+      void
+      _M_park(std::coroutine_handle<_Promise> __h) noexcept
+      {
+	static_assert(std::is_base_of<__task_promise_base, _Promise>::value,
+		      "only a __gnu_cxx::task can wait on the executor");
+	_M_node._M_handle = __h;
+	__h.promise()._M_executor->_M_push_waiting(&_M_node);
+      }
+  };
+
+  /// @endcond
+
+  /**
+   *  @brief  A lazily started coroutine returning @a _Tp.
+   *
+   *  A task does not run until it is either spawned on an executor or
+   *  awaited by another task, in which case it inherits the executor of
+   *  its caller and resumes the caller when it completes.  Its frame is
+   *  allocated from @a _Pool.
+   */
+  template<typename _Tp, typename _Pool>
+    class task
+    {
+    public:
+      struct promise_type : __task_promise_value<_Tp>
+      {
+	task
+	get_return_object() noexcept
+	{ return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+	static void*
+	operator new(std::size_t __n)
+	{ return _Pool::allocate(__n); }
+
+	static void
+	operator delete(void* __p, std::size_t __n) noexcept
+	{ _Pool::deallocate(__p, __n); }
+      };
+
+    private:
+      using _Handle = std::coroutine_handle<promise_type>;
+
+      _Handle _M_handle;
+
+      friend class coroutine_executor;
+
+      explicit
+      task(_Handle __h) noexcept
+      : _M_handle(__h)
+      { }
+
+      struct _Awaiter
+      {
+	_Handle _M_handle;
+
+	bool
+	await_ready() const noexcept
+	{ return false; }
+
+	template<typename _Promise>
+	  std::coroutine_handle<>
+	  await_suspend(std::coroutine_handle<_Promise> __caller) noexcept
+	  {
+	    auto& __p = _M_handle.promise();
+	    __p._M_continuation = __caller;
+	    __p._M_executor = __caller.promise()._M_executor;
+	    return _M_handle;
+	  }
+
+	_Tp
+	await_resume()
+	{ return _M_handle.promise()._M_take(); }
+      };
+
+    public:
+      task(task&& __t) noexcept
+      : _M_handle(std::__exchange(__t._M_handle, nullptr))
+      { }
+
+      task&
+      operator=(task&& __t) noexcept
+      {
+	if (this != &__t)
+	  {
+	    if (_M_handle)
+	      _M_handle.destroy();
+	    _M_handle = std::__exchange(__t._M_handle, nullptr);
+	  }
+	return *this;
+      }
+
+      ~task()
+      {
+	if (_M_handle)
+	  _M_handle.destroy();
+      }
+
+      /// True if the task has run to completion.
+      bool
+      done() const noexcept
+      { return !_M_handle || _M_handle.done(); }
+
+      _Awaiter
+      operator co_await() && noexcept
+      { return _Awaiter{_M_handle}; }
+    };
+
+  /**
+   *  @brief  A binary event that tasks can wait on and ISRs can signal.
+   *
+   *  set() is a single byte store and is safe to call from an interrupt
+   *  handler.  A waiting task is resumed by the next run_once() after the
+   *  event was set.  The event is consumed when it is found set, so a
+   *  set() that arrives after that, even before the task has resumed,
+   *  is kept for the next wait.  Several set() calls before the event is
+   *  consumed count as one.
+   */
+  class coroutine_event
+  {
+    volatile bool _M_set = false;
+
+    // Consume the event if it is set.
+    bool
+    _M_try_take() noexcept
+    {
+      if (!_M_set)
+	return false;
+      _M_set = false;
+      return true;
+    }
+
+    struct _Awaiter : __coro_wait_base
+    {
+      coroutine_event* _M_event;
+
+      static bool
+      _S_poll(__coro_node* __n) noexcept
+      { return static_cast<_Awaiter*>(
+	  reinterpret_cast<__coro_wait_base*>(__n))->_M_event->_M_try_take(); }
+
+      bool
+      await_ready() noexcept
+      { return _M_event->_M_try_take(); }
+
+      template<typename _Promise>
+	void
+	await_suspend(std::coroutine_handle<_Promise> __h) noexcept
+	{
+	  _M_node._M_poll = &_S_poll;
+	  _M_park(__h);
+	}
+
+      void
+      await_resume() const noexcept
+      { }
+    };
+
+  public:
+    constexpr coroutine_event() noexcept = default;
+    coroutine_event(const coroutine_event&) = delete;
+    coroutine_event& operator=(const coroutine_event&) = delete;
+
+    void
+    set() noexcept
+    { _M_set = true; }
+
+    void
+    reset() noexcept
+    { _M_set = false; }
+
+    bool
+    is_set() const noexcept
+    { return _M_set; }
+
+    _Awaiter
+    operator co_await() noexcept
+    { return _Awaiter{{}, this}; }
+  };
+
+  /// @cond undocumented
+
+  template<typename _Clock, typename _Dur>
+    struct __sleep_awaiter : __coro_wait_base
+    {
+      std::chrono::time_point<_Clock, _Dur> _M_deadline;
+
+      static bool
+      _S_poll(__coro_node* __n) noexcept
+      {
+	return !(_Clock::now() < static_cast<__sleep_awaiter*>(
+	    reinterpret_cast<__coro_wait_base*>(__n))->_M_deadline);
+      }
+
+      bool
+      await_ready() const noexcept
+      { return !(_Clock::now() < _M_deadline); }
+
+      template<typename _Promise>
+	void
+	await_suspend(std::coroutine_handle<_Promise> __h) noexcept
+	{
+	  _M_node._M_poll = &_S_poll;
+	  _M_park(__h);
+	}
+
+      void
+      await_resume() const noexcept
+      { }
+    };
+
+  /// @endcond
+
+  /// Suspend the calling task until @a __t has been reached.
+  template<typename _Clock, typename _Dur>
+    inline __sleep_awaiter<_Clock, _Dur>
+    sleep_until(const std::chrono::time_point<_Clock, _Dur>& __t) noexcept
+    { return {{}, __t}; }
+
+  /// Suspend the calling task for at least @a __d.
+  template<typename _Clock = std::chrono::high_resolution_clock,
+	   typename _Rep, typename _Period>
+    inline __sleep_awaiter<_Clock, typename _Clock::duration>
+    sleep_for(const std::chrono::duration<_Rep, _Period>& __d) noexcept
+    {
+      return {{}, _Clock::now()
+	+ std::chrono::duration_cast<typename _Clock::duration>(__d)};
+    }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // __cpp_impl_coroutine
+
+#endif // C++20
+
+#endif // _COROUTINE_EXECUTOR_H
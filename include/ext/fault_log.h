@@ -0,0 +1,152 @@
+// Post-mortem record of library errors -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/fault_log.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Records the errors that would have thrown an exception, such as
+ *  std::vector::at() out of range or a failed allocation, so that they
+ *  can be read after the program has been reset.
+ *
+ *  Without exceptions, the __throw_* functions of src/functexcept.cc
+ *  abort.  If the whole program, including that file, is built with
+ *  MODM_FAULT_LOG defined, they first add a fault_record to a ring of
+ *  MODM_FAULT_LOG_SIZE records (4 by default) in the .noinit section,
+ *  which the startup code does not clear, so the ring survives a reset by
+ *  the watchdog.  A record holds the kind of error, the return address of
+ *  the failed call and the 16-bit id of the message: every message in the
+ *  library headers is replaced by its id at compile time, so no text is
+ *  stored in flash or RAM.  A record that repeats the last one only
+ *  increments its repeat count.
+ *
+ *  @code
+ *  for (std::size_t __i = 0; __i < __gnu_cxx::fault_log::size(); ++__i)
+ *    report(__gnu_cxx::fault_log::get(__i));
+ *  __gnu_cxx::fault_log::clear();
+ *  @endcode
+ *
+ *  The address is that of __builtin_return_address(0) in the __throw_*
+ *  function, in words on AVR; twice it is the byte address to look up
+ *  with addr2line.  fault_log::message_id() computes the id of a message
+ *  text, e.g. on the host, to find the message of a record.
+ */
+
+#ifndef _FAULT_LOG_H
+#define _FAULT_LOG_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(MODM_FAULT_LOG_SIZE)
+#define MODM_FAULT_LOG_SIZE 4
+#endif
+
+#if MODM_FAULT_LOG_SIZE < 1 || MODM_FAULT_LOG_SIZE > 255
+#error "MODM_FAULT_LOG_SIZE must be between 1 and 255"
+#endif
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// The __throw_* function that recorded a fault, or user for
+  /// faults recorded by the program.
+  enum class fault_kind : unsigned char
+  {
+    bad_exception = 1,
+    bad_alloc,
+    bad_cast,
+    bad_typeid,
+    logic_error,
+    domain_error,
+    invalid_argument,
+    length_error,
+    out_of_range,
+    runtime_error,
+    range_error,
+    overflow_error,
+    underflow_error,
+    system_error,
+    bad_function_call,
+    bad_optional_access,
+    bad_variant_access,
+    bad_any_cast,
+    bad_expected_access,
+    bad_weak_ptr,
+    user = 0x80
+  };
+
+  /// One fault, 6 bytes on AVR.
+  struct fault_record
+  {
+    fault_kind kind;
+    /// The number of times the same fault was recorded again right
+    /// after this one, up to 255.
+    unsigned char repeat;
+    /// The id of the message, 0 if there is none, or the error code
+    /// of a system_error.
+    unsigned short message;
+    /// Where the failed call returns to.
+    std::uintptr_t address;
+  };
+
+  /// The faults recorded since the log was last cleared, oldest first.
+  struct fault_log
+  {
+    static constexpr std::size_t capacity = MODM_FAULT_LOG_SIZE;
+
+    /// The number of records held, at most capacity.
+    static std::size_t
+    size() noexcept;
+
+    /// The record @a __i, counted from the oldest.
+    static fault_record
+    get(std::size_t __i) noexcept;
+
+    /// Drop all records.
+    static void
+    clear() noexcept;
+
+    /// Add a record, replacing the oldest if the log is full.  Can be
+    /// called from interrupt handlers.
+    static void
+    record(fault_kind __kind, unsigned short __message,
+	   const void* __address) noexcept;
+
+    /// The id of the message @a __s, as recorded.
+    static constexpr unsigned short
+    message_id(const char* __s) noexcept
+    { return __gnu_cxx::__fault_message_id(__s); }
+  };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++11
+
+#endif // _FAULT_LOG_H
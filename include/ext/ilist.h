@@ -0,0 +1,647 @@
+// Intrusive doubly-linked list -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/ilist.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  A doubly-linked list of objects that are not owned by the list.
+ *
+ *  __gnu_cxx::ilist<_Tp, &_Tp::hook> links objects through a member
+ *  __gnu_cxx::ilist_hook, so inserting and erasing never allocate and
+ *  an object can be in as many lists at once as it has hooks.  The list
+ *  operations are those of std::list (src/list.cc), and the interface
+ *  follows std::list except that elements are inserted by reference and
+ *  erasing an element only unlinks it.
+ *
+ *  @code
+ *  struct job
+ *  {
+ *    __gnu_cxx::ilist_hook ready_hook;
+ *    __gnu_cxx::ilist_hook owner_hook;
+ *  };
+ *  static job __pool[8];
+ *  __gnu_cxx::ilist<job, &job::ready_hook> __ready;
+ *  __ready.push_back(__pool[0]);
+ *  @endcode
+ *
+ *  A hook takes two pointers and a list three words (4 and 6 bytes on
+ *  AVR).  A list does not own its elements: they must outlive their
+ *  membership, and the list unlinks all remaining elements when it is
+ *  destroyed.  An object can be unlinked in constant time through
+ *  ilist::iterator_to without searching the list.
+ */
+
+#ifndef _ILIST_H
+#define _ILIST_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <bits/stl_algobase.h>
+#include <bits/allocator.h>
+#include <bits/range_access.h>
+#include <bits/stl_function.h>
+#include <bits/stl_list.h>
+#include <bits/intrusive_hook.h>
+#include <debug/assertions.h>
+#include <ext/numeric_traits.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief The member through which an object is linked into an ilist.
+   *
+   *  Copying an object does not copy its links: the copy of a hook is
+   *  not linked, and assigning to a hook leaves it unchanged.
+   */
+  class ilist_hook : std::__detail::_List_node_base
+  {
+    template<typename _Tp, ilist_hook _Tp::*>
+      friend class ilist;
+
+  public:
+    ilist_hook() noexcept
+    { _M_clear(); }
+
+    ilist_hook(const ilist_hook&) noexcept
+    { _M_clear(); }
+
+    ilist_hook&
+    operator=(const ilist_hook&) noexcept
+    { return *this; }
+
+    ~ilist_hook()
+    { __glibcxx_assert(!is_linked()); }
+
+    /// Return true if the object is in a list.
+    bool
+    is_linked() const noexcept
+    { return _M_next != nullptr; }
+
+  private:
+    void
+    _M_clear() noexcept
+    { _M_next = _M_prev = nullptr; }
+  };
+
+  /**
+   *  @brief A doubly-linked list of objects linked through the member
+   *  @a _Hook.
+   *
+   *  @tparam _Tp    Type of the elements.
+   *  @tparam _Hook  Pointer to the ilist_hook member of _Tp to link by.
+   */
+  template<typename _Tp, ilist_hook _Tp::* _Hook>
+    class ilist
+    {
+      typedef std::__detail::_List_node_base	_Node_base;
+
+      static _Node_base*
+      _S_node(_Tp& __x) noexcept
+      { return &(__x.*_Hook); }
+
+      static _Tp*
+      _S_value(_Node_base* __n) noexcept
+      { return __gnu_cxx::__hook_owner(static_cast<ilist_hook*>(__n), _Hook); }
+
+      static void
+      _S_clear(_Node_base* __n) noexcept
+      { static_cast<ilist_hook*>(__n)->_M_clear(); }
+
+      template<bool _Const>
+	class _Iterator
+	{
+	  friend class ilist;
+	  friend class _Iterator<!_Const>;
+
+	  explicit
+	  _Iterator(_Node_base* __n) noexcept
+	  : _M_node(__n)
+	  { }
+
+	public:
+	  typedef std::bidirectional_iterator_tag	iterator_category;
+	  typedef _Tp					value_type;
+	  typedef std::ptrdiff_t			difference_type;
+	  typedef typename std::conditional<_Const, const _Tp*, _Tp*>::type
+							pointer;
+	  typedef typename std::conditional<_Const, const _Tp&, _Tp&>::type
+							reference;
+
+	  _Iterator() noexcept
+	  : _M_node()
+	  { }
+
+	  template<bool _C = _Const, typename = typename std::enable_if<_C>::type>
+	    _Iterator(const _Iterator<false>& __it) noexcept
+	    : _M_node(__it._M_node)
+	    { }
+
+	  reference
+	  operator*() const noexcept
+	  { return *_S_value(_M_node); }
+
+	  pointer
+	  operator->() const noexcept
+	  { return _S_value(_M_node); }
+
+	  _Iterator&
+	  operator++() noexcept
+	  {
+	    _M_node = _M_node->_M_next;
+	    return *this;
+	  }
+
+	  _Iterator
+	  operator++(int) noexcept
+	  {
+	    _Iterator __tmp = *this;
+	    _M_node = _M_node->_M_next;
+	    return __tmp;
+	  }
+
+	  _Iterator&
+	  operator--() noexcept
+	  {
+	    _M_node = _M_node->_M_prev;
+	    return *this;
+	  }
+
+	  _Iterator
+	  operator--(int) noexcept
+	  {
+	    _Iterator __tmp = *this;
+	    _M_node = _M_node->_M_prev;
+	    return __tmp;
+	  }
+
+	  friend bool
+	  operator==(const _Iterator& __x, const _Iterator& __y) noexcept
+	  { return __x._M_node == __y._M_node; }
+
+	  friend bool
+	  operator!=(const _Iterator& __x, const _Iterator& __y) noexcept
+	  { return __x._M_node != __y._M_node; }
+
+	private:
+	  _Node_base* _M_node;
+	};
+
+    public:
+      typedef _Tp					value_type;
+      typedef _Tp*					pointer;
+      typedef const _Tp*				const_pointer;
+      typedef _Tp&					reference;
+      typedef const _Tp&				const_reference;
+      typedef _Iterator<false>				iterator;
+      typedef _Iterator<true>				const_iterator;
+      typedef std::reverse_iterator<iterator>		reverse_iterator;
+      typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+      typedef std::size_t				size_type;
+      typedef std::ptrdiff_t				difference_type;
+
+      ilist() = default;
+
+      /// Links the objects in [__first, __last), which must be lvalues.
+      template<typename _InputIterator>
+	ilist(_InputIterator __first, _InputIterator __last) noexcept
+	{ insert(end(), __first, __last); }
+
+      ilist(const ilist&) = delete;
+
+      /// The elements of @a __x are moved to the new list.
+      ilist(ilist&& __x) noexcept
+      : _M_node(std::move(__x._M_node))
+      { }
+
+      ~ilist()
+      { clear(); }
+
+      ilist&
+      operator=(const ilist&) = delete;
+
+      ilist&
+      operator=(ilist&& __x) noexcept
+      {
+	clear();
+	_M_node._M_move_nodes(std::move(__x._M_node));
+	return *this;
+      }
+
+      // iterators
+      iterator
+      begin() noexcept
+      { return iterator(_M_node._M_next); }
+
+      const_iterator
+      begin() const noexcept
+      { return const_iterator(_M_node._M_next); }
+
+      iterator
+      end() noexcept
+      { return iterator(&_M_node); }
+
+      const_iterator
+      end() const noexcept
+      { return const_iterator(_M_end()); }
+
+      reverse_iterator
+      rbegin() noexcept
+      { return reverse_iterator(end()); }
+
+      const_reverse_iterator
+      rbegin() const noexcept
+      { return const_reverse_iterator(end()); }
+
+      reverse_iterator
+      rend() noexcept
+      { return reverse_iterator(begin()); }
+
+      const_reverse_iterator
+      rend() const noexcept
+      { return const_reverse_iterator(begin()); }
+
+      const_iterator
+      cbegin() const noexcept
+      { return begin(); }
+
+      const_iterator
+      cend() const noexcept
+      { return end(); }
+
+      const_reverse_iterator
+      crbegin() const noexcept
+      { return rbegin(); }
+
+      const_reverse_iterator
+      crend() const noexcept
+      { return rend(); }
+
+      /// Return an iterator to @a __x, which must be in this list.
+      static iterator
+      iterator_to(_Tp& __x) noexcept
+      { return iterator(_S_node(__x)); }
+
+      static const_iterator
+      iterator_to(const _Tp& __x) noexcept
+      { return const_iterator(_S_node(const_cast<_Tp&>(__x))); }
+
+      // capacity
+      bool
+      empty() const noexcept
+      { return _M_node._M_next == _M_end(); }
+
+      size_type
+      size() const noexcept
+      { return _M_node._M_size; }
+
+      // element access
+      reference
+      front() noexcept
+      {
+	__glibcxx_assert(!empty());
+	return *begin();
+      }
+
+      const_reference
+      front() const noexcept
+      {
+	__glibcxx_assert(!empty());
+	return *begin();
+      }
+
+      reference
+      back() noexcept
+      {
+	__glibcxx_assert(!empty());
+	return *_S_value(_M_node._M_prev);
+      }
+
+      const_reference
+      back() const noexcept
+      {
+	__glibcxx_assert(!empty());
+	return *_S_value(_M_node._M_prev);
+      }
+
+      // modifiers
+      void
+      push_front(_Tp& __x) noexcept
+      { insert(begin(), __x); }
+
+      void
+      push_back(_Tp& __x) noexcept
+      { insert(end(), __x); }
+
+      void
+      pop_front() noexcept
+      {
+	__glibcxx_assert(!empty());
+	erase(begin());
+      }
+
+      void
+      pop_back() noexcept
+      {
+	__glibcxx_assert(!empty());
+	erase(iterator(_M_node._M_prev));
+      }
+
+      /// Link @a __x, which must not be in a list, before @a __pos.
+      iterator
+      insert(const_iterator __pos, _Tp& __x) noexcept
+      {
+	__glibcxx_assert(!(__x.*_Hook).is_linked());
+	_Node_base* const __n = _S_node(__x);
+	__n->_M_hook(__pos._M_node);
+	++_M_node._M_size;
+	return iterator(__n);
+      }
+
+      /// Link the objects in [__first, __last) before @a __pos.
+      template<typename _InputIterator>
+	iterator
+	insert(const_iterator __pos, _InputIterator __first,
+	       _InputIterator __last) noexcept
+	{
+	  iterator __ret(__pos._M_node);
+	  if (__first != __last)
+	    {
+	      __ret = insert(__pos, *__first);
+	      while (++__first != __last)
+		insert(__pos, *__first);
+	    }
+	  return __ret;
+	}
+
+      /// Unlink the element at @a __pos and return the next one.
+      iterator
+      erase(const_iterator __pos) noexcept
+      {
+	_Node_base* const __n = __pos._M_node;
+	iterator __next(__n->_M_next);
+	__n->_M_unhook();
+	_S_clear(__n);
+	--_M_node._M_size;
+	return __next;
+      }
+
+      iterator
+      erase(const_iterator __first, const_iterator __last) noexcept
+      {
+	while (__first != __last)
+	  __first = erase(__first);
+	return iterator(__last._M_node);
+      }
+
+      /// Unlink all elements.
+      void
+      clear() noexcept
+      {
+	_Node_base* __n = _M_node._M_next;
+	while (__n != &_M_node)
+	  {
+	    _Node_base* const __next = __n->_M_next;
+	    _S_clear(__n);
+	    __n = __next;
+	  }
+	_M_node._M_init();
+      }
+
+      void
+      swap(ilist& __x) noexcept
+      {
+	_Node_base::swap(_M_node, __x._M_node);
+	std::swap(_M_node._M_size, __x._M_node._M_size);
+      }
+
+      // list operations
+      /// Move all elements of @a __x before @a __pos.
+      void
+      splice(const_iterator __pos, ilist& __x) noexcept
+      {
+	if (!__x.empty())
+	  {
+	    __pos._M_node->_M_transfer(__x._M_node._M_next, &__x._M_node);
+	    _M_node._M_size += __x._M_node._M_size;
+	    __x._M_node._M_size = 0;
+	  }
+      }
+
+      void
+      splice(const_iterator __pos, ilist&& __x) noexcept
+      { splice(__pos, __x); }
+
+      /// Move the element at @a __i in @a __x before @a __pos.
+      void
+      splice(const_iterator __pos, ilist& __x, const_iterator __i) noexcept
+      {
+	_Node_base* const __next = __i._M_node->_M_next;
+	if (__pos._M_node == __i._M_node || __pos._M_node == __next)
+	  return;
+	__pos._M_node->_M_transfer(__i._M_node, __next);
+	++_M_node._M_size;
+	--__x._M_node._M_size;
+      }
+
+      void
+      splice(const_iterator __pos, ilist&& __x, const_iterator __i) noexcept
+      { splice(__pos, __x, __i); }
+
+      /// Move the elements in [__first, __last) of @a __x before @a __pos.
+      void
+      splice(const_iterator __pos, ilist& __x, const_iterator __first,
+	     const_iterator __last) noexcept
+      {
+	if (__first != __last)
+	  {
+	    if (this != std::__addressof(__x))
+	      {
+		const size_type __n = std::distance(__first, __last);
+		_M_node._M_size += __n;
+		__x._M_node._M_size -= __n;
+	      }
+	    __pos._M_node->_M_transfer(__first._M_node, __last._M_node);
+	  }
+      }
+
+      void
+      splice(const_iterator __pos, ilist&& __x, const_iterator __first,
+	     const_iterator __last) noexcept
+      { splice(__pos, __x, __first, __last); }
+
+      /// Unlink the elements for which @a __pred is true.
+      template<typename _Predicate>
+	size_type
+	remove_if(_Predicate __pred)
+	{
+	  size_type __removed = 0;
+	  iterator __first = begin();
+	  const iterator __last = end();
+	  while (__first != __last)
+	    if (__pred(*__first))
+	      {
+		__first = erase(__first);
+		++__removed;
+	      }
+	    else
+	      ++__first;
+	  return __removed;
+	}
+
+      void
+      reverse() noexcept
+      { _M_node._M_reverse(); }
+
+      /// Merge the sorted list @a __x into this sorted list.
+      template<typename _Compare>
+	void
+	merge(ilist& __x, _Compare __comp)
+	{
+	  if (this == std::__addressof(__x))
+	    return;
+
+	  iterator __first1 = begin();
+	  const iterator __last1 = end();
+	  iterator __first2 = __x.begin();
+	  const iterator __last2 = __x.end();
+	  const size_type __orig_size = __x.size();
+	  __try
+	    {
+	      while (__first1 != __last1 && __first2 != __last2)
+		if (__comp(*__first2, *__first1))
+		  {
+		    iterator __next = __first2;
+		    ++__next;
+		    __first1._M_node->_M_transfer(__first2._M_node,
+						  __next._M_node);
+		    __first2 = __next;
+		  }
+		else
+		  ++__first1;
+	      if (__first2 != __last2)
+		__last1._M_node->_M_transfer(__first2._M_node, __last2._M_node);
+
+	      _M_node._M_size += __x._M_node._M_size;
+	      __x._M_node._M_size = 0;
+	    }
+	  __catch(...)
+	    {
+	      const size_type __dist = std::distance(__first2, __last2);
+	      _M_node._M_size += __orig_size - __dist;
+	      __x._M_node._M_size = __dist;
+	      __throw_exception_again;
+	    }
+	}
+
+      template<typename _Compare>
+	void
+	merge(ilist&& __x, _Compare __comp)
+	{ merge(__x, __comp); }
+
+      void
+      merge(ilist& __x)
+      { merge(__x, std::less<_Tp>()); }
+
+      void
+      merge(ilist&& __x)
+      { merge(__x, std::less<_Tp>()); }
+
+      /**
+       *  @brief Sort the elements, keeping equivalent ones in order.
+       *
+       *  Like std::list::sort, a merge sort that relinks the elements.
+       *  It keeps one temporary list per bit of size_type on the stack
+       *  (96 bytes on AVR).
+       */
+      template<typename _Compare>
+	void
+	sort(_Compare __comp)
+	{
+	  // Do nothing if the list has length 0 or 1.
+	  if (size() < 2)
+	    return;
+
+	  ilist __carry;
+	  ilist __tmp[__numeric_traits<size_type>::__digits];
+	  ilist* __fill = __tmp;
+	  ilist* __counter;
+	  __try
+	    {
+	      do
+		{
+		  __carry.splice(__carry.begin(), *this, begin());
+
+		  for (__counter = __tmp;
+		       __counter != __fill && !__counter->empty();
+		       ++__counter)
+		    {
+		      __counter->merge(__carry, __comp);
+		      __carry.swap(*__counter);
+		    }
+		  __carry.swap(*__counter);
+		  if (__counter == __fill)
+		    ++__fill;
+		}
+	      while (!empty());
+
+	      for (__counter = __tmp + 1; __counter != __fill; ++__counter)
+		__counter->merge(*(__counter - 1), __comp);
+	      swap(*(__fill - 1));
+	    }
+	  __catch(...)
+	    {
+	      this->splice(this->end(), __carry);
+	      for (ilist& __l : __tmp)
+		this->splice(this->end(), __l);
+	      __throw_exception_again;
+	    }
+	}
+
+      void
+      sort()
+      { sort(std::less<_Tp>()); }
+
+    private:
+      _Node_base*
+      _M_end() const noexcept
+      { return const_cast<std::__detail::_List_node_header*>(&_M_node); }
+
+      std::__detail::_List_node_header _M_node;
+    };
+
+  template<typename _Tp, ilist_hook _Tp::* _Hook>
+    inline void
+    swap(ilist<_Tp, _Hook>& __x, ilist<_Tp, _Hook>& __y) noexcept
+    { __x.swap(__y); }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++11
+
+#endif // _ILIST_H
@@ -0,0 +1,157 @@
+// std::any with a configurable small-object buffer -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/inplace_any.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Type-safe containers of any copy constructible type, like std::any,
+ *  with the size and alignment of the buffer for small objects given as
+ *  template arguments.
+ *
+ *  __gnu_cxx::basic_any<_Size, _Align> stores objects of up to @a _Size
+ *  bytes in place and allocates larger ones.
+ *  __gnu_cxx::inplace_any<_Size, _Align> never allocates: storing an
+ *  object that does not fit, is over-aligned or may throw when moved
+ *  does not compile.
+ *
+ *  @code
+ *  __gnu_cxx::inplace_any<8> __payload = std::uint32_t(42);
+ *  if (auto* __p = __gnu_cxx::any_cast<std::uint32_t>(&__payload))
+ *    ...
+ *  @endcode
+ *
+ *  Both hold a single pointer to a manager function next to the buffer,
+ *  so an inplace_any<8> takes 10 bytes on AVR.  Every size and alignment
+ *  is a distinct type.  std::any is derived from
+ *  basic_any<MODM_ANY_CAPACITY, MODM_ANY_ALIGNMENT>, so its buffer can be
+ *  made larger with these macros.
+ */
+
+#ifndef _INPLACE_ANY_H
+#define _INPLACE_ANY_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <any>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// A basic_any that never allocates.
+  template<std::size_t _Size, std::size_t _Align = alignof(void*)>
+    using inplace_any = basic_any<_Size, _Align, false>;
+
+  /**
+   * @brief Access the contained object.
+   *
+   * @return  The address of the contained object if it is a
+   *          @c _ValueType, otherwise a null pointer.
+   *
+   * @{
+   */
+  template<typename _ValueType, std::size_t _Size, std::size_t _Align,
+	   bool _Allocate>
+    inline const _ValueType*
+    any_cast(const basic_any<_Size, _Align, _Allocate>* __any) noexcept
+    {
+      if constexpr (std::is_object_v<_ValueType>)
+	if (__any)
+	  return static_cast<_ValueType*>(
+	      __basic_any_caster<_ValueType>(__any));
+      return nullptr;
+    }
+
+  template<typename _ValueType, std::size_t _Size, std::size_t _Align,
+	   bool _Allocate>
+    inline _ValueType*
+    any_cast(basic_any<_Size, _Align, _Allocate>* __any) noexcept
+    {
+      if constexpr (std::is_object_v<_ValueType>)
+	if (__any)
+	  return static_cast<_ValueType*>(
+	      __basic_any_caster<_ValueType>(__any));
+      return nullptr;
+    }
+  // @}
+
+  /**
+   * @brief Access the contained object.
+   *
+   * @throw   bad_any_cast If the contained object is not a
+   *          remove_cvref_t<_ValueType>.
+   *
+   * @{
+   */
+  template<typename _ValueType, std::size_t _Size, std::size_t _Align,
+	   bool _Allocate>
+    inline _ValueType
+    any_cast(const basic_any<_Size, _Align, _Allocate>& __any)
+    {
+      using _Up = std::__remove_cvref_t<_ValueType>;
+      static_assert(std::is_constructible_v<_ValueType, const _Up&>,
+	  "Template argument must be constructible from a const value.");
+      auto __p = __gnu_cxx::any_cast<_Up>(&__any);
+      if (__p)
+	return static_cast<_ValueType>(*__p);
+      std::__throw_bad_any_cast();
+    }
+
+  template<typename _ValueType, std::size_t _Size, std::size_t _Align,
+	   bool _Allocate>
+    inline _ValueType
+    any_cast(basic_any<_Size, _Align, _Allocate>& __any)
+    {
+      using _Up = std::__remove_cvref_t<_ValueType>;
+      static_assert(std::is_constructible_v<_ValueType, _Up&>,
+	  "Template argument must be constructible from an lvalue.");
+      auto __p = __gnu_cxx::any_cast<_Up>(&__any);
+      if (__p)
+	return static_cast<_ValueType>(*__p);
+      std::__throw_bad_any_cast();
+    }
+
+  template<typename _ValueType, std::size_t _Size, std::size_t _Align,
+	   bool _Allocate>
+    inline _ValueType
+    any_cast(basic_any<_Size, _Align, _Allocate>&& __any)
+    {
+      using _Up = std::__remove_cvref_t<_ValueType>;
+      static_assert(std::is_constructible_v<_ValueType, _Up>,
+	  "Template argument must be constructible from an rvalue.");
+      auto __p = __gnu_cxx::any_cast<_Up>(&__any);
+      if (__p)
+	return static_cast<_ValueType>(std::move(*__p));
+      std::__throw_bad_any_cast();
+    }
+  // @}
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++17
+
+#endif // _INPLACE_ANY_H
@@ -0,0 +1,467 @@
+// Polymorphic function wrapper with inline storage -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/inplace_function.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  A std::function that never allocates.  The target is always stored
+ *  inside the wrapper, in a buffer of a capacity and alignment given as
+ *  template arguments; a target that does not fit is rejected at compile
+ *  time instead of being moved to the heap.  This makes it usable in
+ *  interrupt handlers and in programs without a heap.
+ *
+ *  @code
+ *  __gnu_cxx::inplace_function<void(std::uint8_t), 6> __on_receive
+ *    = [__port, __count](std::uint8_t __c) { ... };
+ *  @endcode
+ *
+ *  Besides the buffer, a wrapper holds a single pointer to a table of two
+ *  functions shared by all wrappers of the same target type: one to call
+ *  the target and one to copy, move or destroy it.  On AVR an
+ *  inplace_function therefore takes its capacity plus two bytes, where a
+ *  std::function takes eight bytes and allocates every target larger
+ *  than four bytes.  An empty wrapper points to a table whose call
+ *  function reports bad_function_call, so a call needs no test for
+ *  emptiness.
+ *
+ *  The default capacity is MODM_INPLACE_FUNCTION_CAPACITY bytes, four
+ *  pointers unless defined otherwise.
+ */
+
+#ifndef _INPLACE_FUNCTION_H
+#define _INPLACE_FUNCTION_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <functional>
+#include <new>
+
+#if !defined(MODM_INPLACE_FUNCTION_CAPACITY)
+#define MODM_INPLACE_FUNCTION_CAPACITY (4 * sizeof(void*))
+#endif
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template<typename _Signature,
+	   std::size_t _Capacity = MODM_INPLACE_FUNCTION_CAPACITY,
+	   std::size_t _Alignment = __alignof__(std::_Nocopy_types)>
+    class inplace_function;
+
+  enum _Inplace_operation
+  {
+    __inplace_copy,
+    __inplace_move,
+    __inplace_destroy
+  };
+
+  // The functions shared by all wrappers of one target type.  They take
+  // the address of the buffer, so they do not depend on its capacity.
+  template<typename _Res, typename... _ArgTypes>
+    struct _Inplace_vtable
+    {
+      _Res (*_M_invoke)(void*, _ArgTypes&&...);
+      // Copy or move the target at the second address to the first, or
+      // destroy the target at the second address.  A moved-from target
+      // is destroyed as well.
+      void (*_M_manage)(_Inplace_operation, void*, void*);
+    };
+
+  // Copy, move and destruction of trivially copyable targets only depend
+  // on their size, so targets of the same size share one function.
+  template<std::size_t _Size>
+    struct _Inplace_trivial_manager
+    {
+      static void
+      _S_manage(_Inplace_operation __op, void* __dest, void* __source)
+      {
+	if (__op != __inplace_destroy)
+	  __builtin_memcpy(__dest, __source, _Size);
+      }
+    };
+
+  template<typename _Functor>
+    struct _Inplace_manager
+    {
+      static void
+      _S_manage(_Inplace_operation __op, void* __dest, void* __source)
+      {
+	_Functor* __f = static_cast<_Functor*>(__source);
+	switch (__op)
+	  {
+	  case __inplace_copy:
+	    ::new (__dest) _Functor(*__f);
+	    break;
+	  case __inplace_move:
+	    ::new (__dest) _Functor(std::move(*__f));
+	    __f->~_Functor();
+	    break;
+	  case __inplace_destroy:
+	    __f->~_Functor();
+	    break;
+	  }
+      }
+    };
+
+  template<typename _Functor, typename _Res, typename... _ArgTypes>
+    struct _Inplace_handler
+    {
+      static _Res
+      _S_invoke(void* __functor, _ArgTypes&&... __args)
+      {
+	return std::__invoke_r<_Res>(*static_cast<_Functor*>(__functor),
+				     std::forward<_ArgTypes>(__args)...);
+      }
+
+      typedef typename std::conditional<
+	std::is_trivially_copyable<_Functor>::value,
+	_Inplace_trivial_manager<sizeof(_Functor)>,
+	_Inplace_manager<_Functor>>::type _Manager;
+
+      static constexpr _Inplace_vtable<_Res, _ArgTypes...> _S_vtable
+      { &_S_invoke, &_Manager::_S_manage };
+    };
+
+  template<typename _Functor, typename _Res, typename... _ArgTypes>
+    constexpr _Inplace_vtable<_Res, _ArgTypes...>
+    _Inplace_handler<_Functor, _Res, _ArgTypes...>::_S_vtable;
+
+  // The table of every empty wrapper.
+  template<typename _Res, typename... _ArgTypes>
+    struct _Inplace_empty_handler
+    {
+      static _Res
+      _S_invoke(void*, _ArgTypes&&...)
+      { std::__throw_bad_function_call(); }
+
+      static void
+      _S_manage(_Inplace_operation, void*, void*)
+      { }
+
+      static constexpr _Inplace_vtable<_Res, _ArgTypes...> _S_vtable
+      { &_S_invoke, &_S_manage };
+    };
+
+  template<typename _Res, typename... _ArgTypes>
+    constexpr _Inplace_vtable<_Res, _ArgTypes...>
+    _Inplace_empty_handler<_Res, _ArgTypes...>::_S_vtable;
+
+  template<typename _Tp>
+    struct __is_inplace_function
+    : std::false_type
+    { };
+
+  template<typename _Signature, std::size_t _Capacity, std::size_t _Alignment>
+    struct __is_inplace_function<
+      inplace_function<_Signature, _Capacity, _Alignment>>
+    : std::true_type
+    { };
+
+  /**
+   *  @brief Polymorphic function wrapper storing its target inline.
+   *
+   *  Behaves like std::function<_Res(_ArgTypes...)>, except that the
+   *  target must be copy constructible, fit into @a _Capacity bytes and
+   *  have an alignment dividing @a _Alignment.  A moved-from wrapper is
+   *  empty.
+   */
+  template<typename _Res, typename... _ArgTypes, std::size_t _Capacity,
+	   std::size_t _Alignment>
+    class inplace_function<_Res(_ArgTypes...), _Capacity, _Alignment>
+    {
+      static_assert(_Capacity > 0, "inplace_function capacity must not be 0");
+
+      template<typename, std::size_t, std::size_t>
+	friend class inplace_function;
+
+      typedef _Inplace_vtable<_Res, _ArgTypes...> _Vtable;
+      typedef _Inplace_empty_handler<_Res, _ArgTypes...> _Empty;
+
+      template<typename _Func,
+	       typename _Res2 = std::__invoke_result<_Func&, _ArgTypes...>>
+	struct _Callable
+	: std::__is_invocable_impl<_Res2, _Res>::type
+	{ };
+
+      template<typename _Cond, typename _Tp>
+	using _Requires = typename std::enable_if<_Cond::value, _Tp>::type;
+
+      template<typename _Tp>
+	static bool
+	_S_not_empty(_Tp* __fp)
+	{ return __fp != nullptr; }
+
+      template<typename _Class, typename _Tp>
+	static bool
+	_S_not_empty(_Tp _Class::* __mp)
+	{ return __mp != nullptr; }
+
+      template<typename _Signature>
+	static bool
+	_S_not_empty(const std::function<_Signature>& __f)
+	{ return static_cast<bool>(__f); }
+
+      template<typename _Tp>
+	static bool
+	_S_not_empty(const _Tp&)
+	{ return true; }
+
+    public:
+      typedef _Res result_type;
+
+      /// The number of bytes available for the target.
+      static constexpr std::size_t capacity = _Capacity;
+
+      /// The alignment available for the target.
+      static constexpr std::size_t alignment = _Alignment;
+
+      /**
+       *  @brief Default construct creates an empty function call wrapper.
+       *  @post @c !(bool)*this
+       */
+      inplace_function() noexcept
+      : _M_vtable(&_Empty::_S_vtable)
+      { }
+
+      /**
+       *  @brief Creates an empty function call wrapper.
+       *  @post @c !(bool)*this
+       */
+      inplace_function(std::nullptr_t) noexcept
+      : _M_vtable(&_Empty::_S_vtable)
+      { }
+
+      /**
+       *  @brief Builds a wrapper targeting a copy of @a __f.
+       *
+       *  If @a __f is a null function pointer, a null pointer to member
+       *  or an empty std::function, the new wrapper is empty.  A target
+       *  that does not fit into the buffer is a compile-time error.
+       */
+      template<typename _Functor,
+	       typename _Fn = typename std::decay<_Functor>::type,
+	       typename = _Requires<std::__not_<__is_inplace_function<_Fn>>,
+				    void>,
+	       typename = _Requires<_Callable<_Fn>, void>>
+	inplace_function(_Functor&& __f)
+	: _M_vtable(&_Empty::_S_vtable)
+	{
+	  static_assert(sizeof(_Fn) <= _Capacity,
+			"inplace_function target must fit into its capacity");
+	  static_assert(_Alignment % __alignof__(_Fn) == 0,
+			"inplace_function target must not be over-aligned");
+	  static_assert(std::is_copy_constructible<_Fn>::value,
+			"inplace_function target must be copy constructible");
+
+	  if (_S_not_empty(__f))
+	    {
+	      ::new (_M_access()) _Fn(std::forward<_Functor>(__f));
+	      _M_vtable = &_Inplace_handler<_Fn, _Res, _ArgTypes...>::_S_vtable;
+	    }
+	}
+
+      /**
+       *  @brief Copies the target of a wrapper with an equal or smaller
+       *  buffer.  Both wrappers share the table of the target, so no
+       *  second wrapper is built around the first.
+       */
+      template<std::size_t _Cap2, std::size_t _Align2>
+	inplace_function(const inplace_function<_Res(_ArgTypes...),
+						_Cap2, _Align2>& __x)
+	: _M_vtable(&_Empty::_S_vtable)
+	{
+	  static_assert(_Cap2 <= _Capacity && _Alignment % _Align2 == 0,
+			"inplace_function target must fit into its capacity");
+	  __x._M_vtable->_M_manage(__inplace_copy, _M_access(),
+				   const_cast<void*>(__x._M_access()));
+	  _M_vtable = __x._M_vtable;
+	}
+
+      /// @overload
+      template<std::size_t _Cap2, std::size_t _Align2>
+	inplace_function(inplace_function<_Res(_ArgTypes...),
+					  _Cap2, _Align2>&& __x) noexcept
+	: _M_vtable(__x._M_vtable)
+	{
+	  static_assert(_Cap2 <= _Capacity && _Alignment % _Align2 == 0,
+			"inplace_function target must fit into its capacity");
+	  _M_vtable->_M_manage(__inplace_move, _M_access(), __x._M_access());
+	  __x._M_vtable = &_Empty::_S_vtable;
+	}
+
+      inplace_function(const inplace_function& __x)
+      : _M_vtable(__x._M_vtable)
+      {
+	_M_vtable->_M_manage(__inplace_copy, _M_access(),
+			     const_cast<void*>(__x._M_access()));
+      }
+
+      /// The target of @a __x is moved, and @a __x is left empty.
+      inplace_function(inplace_function&& __x) noexcept
+      : _M_vtable(__x._M_vtable)
+      {
+	_M_vtable->_M_manage(__inplace_move, _M_access(), __x._M_access());
+	__x._M_vtable = &_Empty::_S_vtable;
+      }
+
+      ~inplace_function()
+      { _M_vtable->_M_manage(__inplace_destroy, nullptr, _M_access()); }
+
+      inplace_function&
+      operator=(const inplace_function& __x)
+      {
+	if (this != &__x)
+	  {
+	    _M_reset();
+	    __x._M_vtable->_M_manage(__inplace_copy, _M_access(),
+				     const_cast<void*>(__x._M_access()));
+	    _M_vtable = __x._M_vtable;
+	  }
+	return *this;
+      }
+
+      inplace_function&
+      operator=(inplace_function&& __x) noexcept
+      {
+	if (this != &__x)
+	  {
+	    _M_reset();
+	    __x._M_vtable->_M_manage(__inplace_move, _M_access(),
+				     __x._M_access());
+	    _M_vtable = __x._M_vtable;
+	    __x._M_vtable = &_Empty::_S_vtable;
+	  }
+	return *this;
+      }
+
+      inplace_function&
+      operator=(std::nullptr_t) noexcept
+      {
+	_M_reset();
+	return *this;
+      }
+
+      template<typename _Functor>
+	_Requires<_Callable<typename std::decay<_Functor>::type>,
+		  inplace_function&>
+	operator=(_Functor&& __f)
+	{
+	  *this = inplace_function(std::forward<_Functor>(__f));
+	  return *this;
+	}
+
+      /// Swap the targets of two wrappers.
+      void
+      swap(inplace_function& __x) noexcept
+      {
+	if (this == &__x)
+	  return;
+	_Storage __tmp;
+	__x._M_vtable->_M_manage(__inplace_move, &__tmp, __x._M_access());
+	_M_vtable->_M_manage(__inplace_move, __x._M_access(), _M_access());
+	__x._M_vtable->_M_manage(__inplace_move, _M_access(), &__tmp);
+	std::swap(_M_vtable, __x._M_vtable);
+      }
+
+      /// Determine if the wrapper has a target.
+      explicit operator bool() const noexcept
+      { return _M_vtable != &_Empty::_S_vtable; }
+
+      /**
+       *  @brief Invokes the target.
+       *  @throws bad_function_call when @c !(bool)*this
+       */
+      _Res
+      operator()(_ArgTypes... __args) const
+      {
+	return _M_vtable->_M_invoke(const_cast<void*>(_M_access()),
+				    std::forward<_ArgTypes>(__args)...);
+      }
+
+    private:
+      typedef typename std::aligned_storage<_Capacity, _Alignment>::type
+	_Storage;
+
+      void*
+      _M_access() noexcept
+      { return &_M_storage; }
+
+      const void*
+      _M_access() const noexcept
+      { return &_M_storage; }
+
+      void
+      _M_reset() noexcept
+      {
+	_M_vtable->_M_manage(__inplace_destroy, nullptr, _M_access());
+	_M_vtable = &_Empty::_S_vtable;
+      }
+
+      const _Vtable* _M_vtable;
+      _Storage _M_storage;
+    };
+
+  template<typename _Signature, std::size_t _Capacity, std::size_t _Alignment>
+    inline bool
+    operator==(const inplace_function<_Signature, _Capacity, _Alignment>& __f,
+	       std::nullptr_t) noexcept
+    { return !static_cast<bool>(__f); }
+
+#if __cpp_impl_three_way_comparison < 201907L
+  template<typename _Signature, std::size_t _Capacity, std::size_t _Alignment>
+    inline bool
+    operator==(std::nullptr_t,
+	       const inplace_function<_Signature, _Capacity, _Alignment>& __f)
+    noexcept
+    { return !static_cast<bool>(__f); }
+
+  template<typename _Signature, std::size_t _Capacity, std::size_t _Alignment>
+    inline bool
+    operator!=(const inplace_function<_Signature, _Capacity, _Alignment>& __f,
+	       std::nullptr_t) noexcept
+    { return static_cast<bool>(__f); }
+
+  template<typename _Signature, std::size_t _Capacity, std::size_t _Alignment>
+    inline bool
+    operator!=(std::nullptr_t,
+	       const inplace_function<_Signature, _Capacity, _Alignment>& __f)
+    noexcept
+    { return static_cast<bool>(__f); }
+#endif
+
+  template<typename _Signature, std::size_t _Capacity, std::size_t _Alignment>
+    inline void
+    swap(inplace_function<_Signature, _Capacity, _Alignment>& __x,
+	 inplace_function<_Signature, _Capacity, _Alignment>& __y) noexcept
+    { __x.swap(__y); }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++11
+
+#endif // _INPLACE_FUNCTION_H
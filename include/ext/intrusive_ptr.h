@@ -0,0 +1,358 @@
+// Smart pointer to objects with an embedded reference count -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/intrusive_ptr.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  A smart pointer to objects that keep their own reference count, in the
+ *  style of boost::intrusive_ptr.
+ *
+ *  __gnu_cxx::intrusive_ptr<_Tp> is a single pointer.  Copying it calls
+ *  intrusive_ptr_add_ref(__p) and destroying it intrusive_ptr_release(__p),
+ *  both found by argument-dependent lookup, so the object decides where
+ *  its count lives and what happens when it drops to zero, e.g. returning
+ *  the object to a static pool instead of deleting it.
+ *
+ *  @code
+ *  struct buffer : __gnu_cxx::intrusive_ref_counter<buffer>
+ *  { std::uint8_t data[32]; };
+ *  __gnu_cxx::intrusive_ptr<buffer> __p(new buffer);
+ *  @endcode
+ *
+ *  __gnu_cxx::intrusive_ref_counter<_Derived> provides both functions for
+ *  objects allocated with new.  Its count is as wide as the counts of
+ *  std::shared_ptr (MODM_SHARED_PTR_COUNT_WIDTH), is updated with the
+ *  same lock policy (MODM_SHARED_PTR_ATOMIC) and aborts the same way
+ *  when it would overflow.
+ */
+
+#ifndef _INTRUSIVE_PTR_H
+#define _INTRUSIVE_PTR_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <bits/shared_ptr_base.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief A pointer that shares ownership of an object through the
+   *  object's own reference count.
+   */
+  template<typename _Tp>
+    class intrusive_ptr
+    {
+      template<typename _Up>
+	using _Compatible
+	  = typename std::enable_if<std::is_convertible<_Up*, _Tp*>::value>::type;
+
+    public:
+      typedef _Tp element_type;
+
+      constexpr intrusive_ptr() noexcept
+      : _M_ptr(nullptr)
+      { }
+
+      constexpr intrusive_ptr(std::nullptr_t) noexcept
+      : _M_ptr(nullptr)
+      { }
+
+      /// Share @a __p, adding a reference unless @a __add_ref is false.
+      intrusive_ptr(_Tp* __p, bool __add_ref = true)
+      : _M_ptr(__p)
+      {
+	if (_M_ptr != nullptr && __add_ref)
+	  intrusive_ptr_add_ref(_M_ptr);
+      }
+
+      intrusive_ptr(const intrusive_ptr& __r)
+      : _M_ptr(__r._M_ptr)
+      {
+	if (_M_ptr != nullptr)
+	  intrusive_ptr_add_ref(_M_ptr);
+      }
+
+      template<typename _Up, typename = _Compatible<_Up>>
+	intrusive_ptr(const intrusive_ptr<_Up>& __r)
+	: _M_ptr(__r.get())
+	{
+	  if (_M_ptr != nullptr)
+	    intrusive_ptr_add_ref(_M_ptr);
+	}
+
+      intrusive_ptr(intrusive_ptr&& __r) noexcept
+      : _M_ptr(__r._M_ptr)
+      { __r._M_ptr = nullptr; }
+
+      template<typename _Up, typename = _Compatible<_Up>>
+	intrusive_ptr(intrusive_ptr<_Up>&& __r) noexcept
+	: _M_ptr(__r.detach())
+	{ }
+
+      ~intrusive_ptr()
+      {
+	if (_M_ptr != nullptr)
+	  intrusive_ptr_release(_M_ptr);
+      }
+
+      intrusive_ptr&
+      operator=(const intrusive_ptr& __r)
+      {
+	intrusive_ptr(__r).swap(*this);
+	return *this;
+      }
+
+      template<typename _Up>
+	typename std::enable_if<std::is_convertible<_Up*, _Tp*>::value,
+				intrusive_ptr&>::type
+	operator=(const intrusive_ptr<_Up>& __r)
+	{
+	  intrusive_ptr(__r).swap(*this);
+	  return *this;
+	}
+
+      intrusive_ptr&
+      operator=(intrusive_ptr&& __r) noexcept
+      {
+	intrusive_ptr(std::move(__r)).swap(*this);
+	return *this;
+      }
+
+      template<typename _Up>
+	typename std::enable_if<std::is_convertible<_Up*, _Tp*>::value,
+				intrusive_ptr&>::type
+	operator=(intrusive_ptr<_Up>&& __r) noexcept
+	{
+	  intrusive_ptr(std::move(__r)).swap(*this);
+	  return *this;
+	}
+
+      intrusive_ptr&
+      operator=(_Tp* __p)
+      {
+	intrusive_ptr(__p).swap(*this);
+	return *this;
+      }
+
+      void
+      reset() noexcept
+      { intrusive_ptr().swap(*this); }
+
+      void
+      reset(_Tp* __p, bool __add_ref = true)
+      { intrusive_ptr(__p, __add_ref).swap(*this); }
+
+      /// Give up the reference without releasing it and return the pointer.
+      _Tp*
+      detach() noexcept
+      {
+	_Tp* __p = _M_ptr;
+	_M_ptr = nullptr;
+	return __p;
+      }
+
+      _Tp*
+      get() const noexcept
+      { return _M_ptr; }
+
+      _Tp&
+      operator*() const noexcept
+      {
+	__glibcxx_assert(_M_ptr != nullptr);
+	return *_M_ptr;
+      }
+
+      _Tp*
+      operator->() const noexcept
+      {
+	_GLIBCXX_DEBUG_PEDASSERT(_M_ptr != nullptr);
+	return _M_ptr;
+      }
+
+      explicit operator bool() const noexcept
+      { return _M_ptr != nullptr; }
+
+      void
+      swap(intrusive_ptr& __r) noexcept
+      { std::swap(_M_ptr, __r._M_ptr); }
+
+    private:
+      _Tp* _M_ptr;
+    };
+
+  template<typename _Tp, typename _Up>
+    inline bool
+    operator==(const intrusive_ptr<_Tp>& __a,
+	       const intrusive_ptr<_Up>& __b) noexcept
+    { return __a.get() == __b.get(); }
+
+  template<typename _Tp, typename _Up>
+    inline bool
+    operator!=(const intrusive_ptr<_Tp>& __a,
+	       const intrusive_ptr<_Up>& __b) noexcept
+    { return __a.get() != __b.get(); }
+
+  template<typename _Tp, typename _Up>
+    inline bool
+    operator==(const intrusive_ptr<_Tp>& __a, _Up* __b) noexcept
+    { return __a.get() == __b; }
+
+  template<typename _Tp, typename _Up>
+    inline bool
+    operator!=(const intrusive_ptr<_Tp>& __a, _Up* __b) noexcept
+    { return __a.get() != __b; }
+
+  template<typename _Tp>
+    inline bool
+    operator==(const intrusive_ptr<_Tp>& __a, std::nullptr_t) noexcept
+    { return !__a; }
+
+  template<typename _Tp>
+    inline bool
+    operator!=(const intrusive_ptr<_Tp>& __a, std::nullptr_t) noexcept
+    { return static_cast<bool>(__a); }
+
+#if __cpp_impl_three_way_comparison < 201907L
+  template<typename _Tp, typename _Up>
+    inline bool
+    operator==(_Tp* __a, const intrusive_ptr<_Up>& __b) noexcept
+    { return __a == __b.get(); }
+
+  template<typename _Tp, typename _Up>
+    inline bool
+    operator!=(_Tp* __a, const intrusive_ptr<_Up>& __b) noexcept
+    { return __a != __b.get(); }
+
+  template<typename _Tp>
+    inline bool
+    operator==(std::nullptr_t, const intrusive_ptr<_Tp>& __a) noexcept
+    { return !__a; }
+
+  template<typename _Tp>
+    inline bool
+    operator!=(std::nullptr_t, const intrusive_ptr<_Tp>& __a) noexcept
+    { return static_cast<bool>(__a); }
+#endif
+
+  template<typename _Tp>
+    inline bool
+    operator<(const intrusive_ptr<_Tp>& __a,
+	      const intrusive_ptr<_Tp>& __b) noexcept
+    { return std::less<_Tp*>()(__a.get(), __b.get()); }
+
+  template<typename _Tp>
+    inline void
+    swap(intrusive_ptr<_Tp>& __a, intrusive_ptr<_Tp>& __b) noexcept
+    { __a.swap(__b); }
+
+  template<typename _Tp, typename _Up>
+    inline intrusive_ptr<_Tp>
+    static_pointer_cast(const intrusive_ptr<_Up>& __r)
+    { return static_cast<_Tp*>(__r.get()); }
+
+  template<typename _Tp, typename _Up>
+    inline intrusive_ptr<_Tp>
+    const_pointer_cast(const intrusive_ptr<_Up>& __r)
+    { return const_cast<_Tp*>(__r.get()); }
+
+#if __cpp_rtti
+  template<typename _Tp, typename _Up>
+    inline intrusive_ptr<_Tp>
+    dynamic_pointer_cast(const intrusive_ptr<_Up>& __r)
+    { return dynamic_cast<_Tp*>(__r.get()); }
+#endif
+
+  /**
+   *  @brief A base class that counts the intrusive_ptrs to an object of
+   *  the derived class @a _Derived, and deletes the object with the last.
+   *
+   *  Copying an object does not copy its count.
+   */
+  template<typename _Derived,
+	   std::_Lock_policy _Lp = std::__default_lock_policy>
+    class intrusive_ref_counter
+    {
+    public:
+      /// The number of intrusive_ptrs to this object.
+      long
+      use_count() const noexcept
+      { return std::_Sp_counter<_Lp>::_S_get(_M_count); }
+
+    protected:
+      constexpr intrusive_ref_counter() noexcept
+      : _M_count(0)
+      { }
+
+      intrusive_ref_counter(const intrusive_ref_counter&) noexcept
+      : _M_count(0)
+      { }
+
+      intrusive_ref_counter&
+      operator=(const intrusive_ref_counter&) noexcept
+      { return *this; }
+
+      ~intrusive_ref_counter() = default;
+
+    private:
+      friend void
+      intrusive_ptr_add_ref(const intrusive_ref_counter* __p) noexcept
+      { std::_Sp_counter<_Lp>::_S_add_ref(__p->_M_count); }
+
+      friend void
+      intrusive_ptr_release(const intrusive_ref_counter* __p) noexcept
+      {
+	if (std::_Sp_counter<_Lp>::_S_release(__p->_M_count))
+	  delete static_cast<const _Derived*>(__p);
+      }
+
+      mutable std::_Sp_count_type _M_count;
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// std::hash specialization for __gnu_cxx::intrusive_ptr.
+  template<typename _Tp>
+    struct hash<__gnu_cxx::intrusive_ptr<_Tp>>
+    : public __hash_base<size_t, __gnu_cxx::intrusive_ptr<_Tp>>
+    {
+      size_t
+      operator()(const __gnu_cxx::intrusive_ptr<_Tp>& __p) const noexcept
+      { return std::hash<_Tp*>()(__p.get()); }
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // C++11
+
+#endif // _INTRUSIVE_PTR_H
@@ -0,0 +1,626 @@
+// Intrusive ordered sets and maps -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/iset.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Red-black trees of objects that are not owned by the tree.
+ *
+ *  __gnu_cxx::iset<_Tp, &_Tp::hook> orders objects by operator< (or a
+ *  given comparison), and __gnu_cxx::imap<_Key, _Tp, &_Tp::hook, &_Tp::key>
+ *  orders them by one of their data members.  Both link objects through a
+ *  member __gnu_cxx::iset_hook, so inserting and erasing never allocate
+ *  and an object can be in as many trees at once as it has hooks.  The
+ *  tree is balanced by the algorithms of std::set and std::map
+ *  (src/tree.cc), and the interface follows std::set except that elements
+ *  are inserted by reference and erasing an element only unlinks it.
+ *  Keys are unique.
+ *
+ *  @code
+ *  struct channel
+ *  {
+ *    std::uint8_t id;
+ *    __gnu_cxx::iset_hook by_id;
+ *  };
+ *  static channel __pool[8];
+ *  __gnu_cxx::imap<std::uint8_t, channel, &channel::by_id, &channel::id> __channels;
+ *  __channels.insert(__pool[0]);
+ *  auto __it = __channels.find(3);
+ *  @endcode
+ *
+ *  A hook takes a color and three pointers (8 bytes on AVR).  The key of
+ *  an element must not change while it is linked.  A tree does not own
+ *  its elements: they must outlive their membership, and the tree unlinks
+ *  all remaining elements when it is destroyed.
+ */
+
+#ifndef _ISET_H
+#define _ISET_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <bits/stl_tree.h>
+#include <bits/range_access.h>
+#include <bits/intrusive_hook.h>
+#include <debug/assertions.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  class iset_hook;
+
+  template<typename _Key, typename _Tp, iset_hook _Tp::* _Hook,
+	   typename _KeyOfValue, typename _Compare>
+    class __irb_tree;
+
+  /**
+   *  @brief The member through which an object is linked into an iset or
+   *  imap.
+   *
+   *  Copying an object does not copy its links: the copy of a hook is
+   *  not linked, and assigning to a hook leaves it unchanged.
+   */
+  class iset_hook : std::_Rb_tree_node_base
+  {
+    template<typename _Key, typename _Tp, iset_hook _Tp::* _Hook,
+	     typename _KeyOfValue, typename _Compare>
+      friend class __irb_tree;
+
+  public:
+    iset_hook() noexcept
+    { _M_clear(); }
+
+    iset_hook(const iset_hook&) noexcept
+    { _M_clear(); }
+
+    iset_hook&
+    operator=(const iset_hook&) noexcept
+    { return *this; }
+
+    ~iset_hook()
+    { __glibcxx_assert(!is_linked()); }
+
+    /// Return true if the object is in a tree.
+    bool
+    is_linked() const noexcept
+    { return _M_parent != nullptr; }
+
+  private:
+    // The root of a tree has the header as its parent, so only nodes
+    // outside of any tree have none.
+    void
+    _M_clear() noexcept
+    {
+      _M_color = std::_S_red;
+      _M_parent = _M_left = _M_right = nullptr;
+    }
+  };
+
+  // The key of an imap element, the data member _Member of it.
+  template<typename _Key, typename _Tp, _Key _Tp::* _Member>
+    struct __key_member
+    {
+      const _Key&
+      operator()(const _Tp& __x) const noexcept
+      { return __x.*_Member; }
+    };
+
+  /**
+   *  @brief The red-black tree behind iset and imap.
+   *
+   *  @tparam _Key         Type of the keys.
+   *  @tparam _Tp          Type of the elements.
+   *  @tparam _Hook        Pointer to the iset_hook member of _Tp.
+   *  @tparam _KeyOfValue  Function object returning the key of an element.
+   *  @tparam _Compare     Comparison of keys.
+   */
+  template<typename _Key, typename _Tp, iset_hook _Tp::* _Hook,
+	   typename _KeyOfValue, typename _Compare>
+    class __irb_tree
+    {
+      typedef std::_Rb_tree_node_base*		_Base_ptr;
+
+      struct _Impl
+      : public std::_Rb_tree_key_compare<_Compare>,
+	public std::_Rb_tree_header
+      {
+	_Impl() = default;
+
+	explicit
+	_Impl(const _Compare& __comp)
+	: std::_Rb_tree_key_compare<_Compare>(__comp)
+	{ }
+
+	_Impl(_Impl&&) = default;
+      };
+
+      static _Base_ptr
+      _S_node(_Tp& __x) noexcept
+      { return &(__x.*_Hook); }
+
+      static _Tp*
+      _S_value(_Base_ptr __n) noexcept
+      { return __gnu_cxx::__hook_owner(static_cast<iset_hook*>(__n), _Hook); }
+
+      static const _Key&
+      _S_key(_Base_ptr __n) noexcept
+      { return _KeyOfValue()(*_S_value(__n)); }
+
+      template<bool _Const>
+	class _Iterator
+	{
+	  friend class __irb_tree;
+	  friend class _Iterator<!_Const>;
+
+	  explicit
+	  _Iterator(_Base_ptr __n) noexcept
+	  : _M_node(__n)
+	  { }
+
+	public:
+	  typedef std::bidirectional_iterator_tag	iterator_category;
+	  typedef _Tp					value_type;
+	  typedef std::ptrdiff_t			difference_type;
+	  typedef typename std::conditional<_Const, const _Tp*, _Tp*>::type
+							pointer;
+	  typedef typename std::conditional<_Const, const _Tp&, _Tp&>::type
+							reference;
+
+	  _Iterator() noexcept
+	  : _M_node()
+	  { }
+
+	  template<bool _C = _Const, typename = typename std::enable_if<_C>::type>
+	    _Iterator(const _Iterator<false>& __it) noexcept
+	    : _M_node(__it._M_node)
+	    { }
+
+	  reference
+	  operator*() const noexcept
+	  { return *_S_value(_M_node); }
+
+	  pointer
+	  operator->() const noexcept
+	  { return _S_value(_M_node); }
+
+	  _Iterator&
+	  operator++() noexcept
+	  {
+	    _M_node = std::_Rb_tree_increment(_M_node);
+	    return *this;
+	  }
+
+	  _Iterator
+	  operator++(int) noexcept
+	  {
+	    _Iterator __tmp = *this;
+	    _M_node = std::_Rb_tree_increment(_M_node);
+	    return __tmp;
+	  }
+
+	  _Iterator&
+	  operator--() noexcept
+	  {
+	    _M_node = std::_Rb_tree_decrement(_M_node);
+	    return *this;
+	  }
+
+	  _Iterator
+	  operator--(int) noexcept
+	  {
+	    _Iterator __tmp = *this;
+	    _M_node = std::_Rb_tree_decrement(_M_node);
+	    return __tmp;
+	  }
+
+	  friend bool
+	  operator==(const _Iterator& __x, const _Iterator& __y) noexcept
+	  { return __x._M_node == __y._M_node; }
+
+	  friend bool
+	  operator!=(const _Iterator& __x, const _Iterator& __y) noexcept
+	  { return __x._M_node != __y._M_node; }
+
+	private:
+	  _Base_ptr _M_node;
+	};
+
+    public:
+      typedef _Key					key_type;
+      typedef _Tp					value_type;
+      typedef _Compare					key_compare;
+      typedef _Tp*					pointer;
+      typedef const _Tp*				const_pointer;
+      typedef _Tp&					reference;
+      typedef const _Tp&				const_reference;
+      typedef _Iterator<false>				iterator;
+      typedef _Iterator<true>				const_iterator;
+      typedef std::reverse_iterator<iterator>		reverse_iterator;
+      typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+      typedef std::size_t				size_type;
+      typedef std::ptrdiff_t				difference_type;
+
+      __irb_tree() = default;
+
+      explicit
+      __irb_tree(const _Compare& __comp)
+      : _M_impl(__comp)
+      { }
+
+      /// Links the objects in [__first, __last), which must be lvalues.
+      template<typename _InputIterator>
+	__irb_tree(_InputIterator __first, _InputIterator __last,
+		   const _Compare& __comp = _Compare())
+	: _M_impl(__comp)
+	{ insert(__first, __last); }
+
+      __irb_tree(const __irb_tree&) = delete;
+
+      /// The elements of @a __x are moved to the new tree.
+      __irb_tree(__irb_tree&&) = default;
+
+      ~__irb_tree()
+      { clear(); }
+
+      __irb_tree&
+      operator=(const __irb_tree&) = delete;
+
+      __irb_tree&
+      operator=(__irb_tree&& __x)
+      noexcept(std::is_nothrow_copy_assignable<_Compare>::value)
+      {
+	clear();
+	_M_impl._M_key_compare = __x._M_impl._M_key_compare;
+	if (__x._M_root() != nullptr)
+	  _M_impl._M_move_data(__x._M_impl);
+	return *this;
+      }
+
+      key_compare
+      key_comp() const
+      { return _M_impl._M_key_compare; }
+
+      // iterators
+      iterator
+      begin() noexcept
+      { return iterator(_M_impl._M_header._M_left); }
+
+      const_iterator
+      begin() const noexcept
+      { return const_iterator(_M_impl._M_header._M_left); }
+
+      iterator
+      end() noexcept
+      { return iterator(_M_end()); }
+
+      const_iterator
+      end() const noexcept
+      { return const_iterator(_M_end()); }
+
+      reverse_iterator
+      rbegin() noexcept
+      { return reverse_iterator(end()); }
+
+      const_reverse_iterator
+      rbegin() const noexcept
+      { return const_reverse_iterator(end()); }
+
+      reverse_iterator
+      rend() noexcept
+      { return reverse_iterator(begin()); }
+
+      const_reverse_iterator
+      rend() const noexcept
+      { return const_reverse_iterator(begin()); }
+
+      const_iterator
+      cbegin() const noexcept
+      { return begin(); }
+
+      const_iterator
+      cend() const noexcept
+      { return end(); }
+
+      const_reverse_iterator
+      crbegin() const noexcept
+      { return rbegin(); }
+
+      const_reverse_iterator
+      crend() const noexcept
+      { return rend(); }
+
+      /// Return an iterator to @a __x, which must be in this tree.
+      static iterator
+      iterator_to(_Tp& __x) noexcept
+      { return iterator(_S_node(__x)); }
+
+      static const_iterator
+      iterator_to(const _Tp& __x) noexcept
+      { return const_iterator(_S_node(const_cast<_Tp&>(__x))); }
+
+      // capacity
+      bool
+      empty() const noexcept
+      { return _M_impl._M_node_count == 0; }
+
+      size_type
+      size() const noexcept
+      { return _M_impl._M_node_count; }
+
+      // modifiers
+      /**
+       *  @brief Link @a __x, which must not be in a tree, unless an element
+       *  with an equivalent key is already linked.
+       *  @return An iterator to the element with the key of @a __x, and
+       *  true if @a __x was linked.
+       */
+      std::pair<iterator, bool>
+      insert(_Tp& __x)
+      {
+	__glibcxx_assert(!(__x.*_Hook).is_linked());
+	const _Key& __k = _KeyOfValue()(__x);
+	_Base_ptr __p = _M_root();
+	_Base_ptr __y = _M_end();
+	bool __comp = true;
+	while (__p != nullptr)
+	  {
+	    __y = __p;
+	    __comp = _M_impl._M_key_compare(__k, _S_key(__p));
+	    __p = __comp ? __p->_M_left : __p->_M_right;
+	  }
+	iterator __j(__y);
+	if (__comp)
+	  {
+	    if (__j == begin())
+	      return { _M_insert(true, _S_node(__x), __y), true };
+	    --__j;
+	  }
+	if (_M_impl._M_key_compare(_S_key(__j._M_node), __k))
+	  return { _M_insert(__comp || __y == _M_end(), _S_node(__x), __y),
+		   true };
+	return { __j, false };
+      }
+
+      /// Link the objects in [__first, __last) whose keys are not in use.
+      template<typename _InputIterator>
+	void
+	insert(_InputIterator __first, _InputIterator __last)
+	{
+	  for (; __first != __last; ++__first)
+	    insert(*__first);
+	}
+
+      /// Unlink the element at @a __pos and return the next one.
+      iterator
+      erase(const_iterator __pos) noexcept
+      {
+	_Base_ptr const __n = __pos._M_node;
+	iterator __next(std::_Rb_tree_increment(__n));
+	std::_Rb_tree_rebalance_for_erase(__n, _M_impl._M_header);
+	static_cast<iset_hook*>(__n)->_M_clear();
+	--_M_impl._M_node_count;
+	return __next;
+      }
+
+      iterator
+      erase(const_iterator __first, const_iterator __last) noexcept
+      {
+	if (__first == cbegin() && __last == cend())
+	  clear();
+	else
+	  while (__first != __last)
+	    __first = erase(__first);
+	return iterator(__last._M_node);
+      }
+
+      /// Unlink the element with key @a __k, if any.
+      size_type
+      erase(const key_type& __k)
+      {
+	iterator __it = find(__k);
+	if (__it == end())
+	  return 0;
+	erase(__it);
+	return 1;
+      }
+
+      /// Unlink all elements.
+      void
+      clear() noexcept
+      {
+	_S_clear(_M_root());
+	_M_impl._M_reset();
+      }
+
+      void
+      swap(__irb_tree& __x)
+      noexcept(std::__is_nothrow_swappable<_Compare>::value)
+      {
+	using std::swap;
+	swap(_M_impl._M_key_compare, __x._M_impl._M_key_compare);
+	std::_Rb_tree_header __tmp;
+	if (__x._M_root() != nullptr)
+	  __tmp._M_move_data(__x._M_impl);
+	if (_M_root() != nullptr)
+	  __x._M_impl._M_move_data(_M_impl);
+	if (__tmp._M_header._M_parent != nullptr)
+	  _M_impl._M_move_data(__tmp);
+      }
+
+      // lookup
+      iterator
+      find(const key_type& __k)
+      {
+	iterator __j(_M_lower_bound(__k));
+	return (__j == end() || _M_impl._M_key_compare(__k, _S_key(__j._M_node)))
+	  ? end() : __j;
+      }
+
+      const_iterator
+      find(const key_type& __k) const
+      { return const_cast<__irb_tree*>(this)->find(__k); }
+
+      size_type
+      count(const key_type& __k) const
+      { return find(__k) != end(); }
+
+      bool
+      contains(const key_type& __k) const
+      { return find(__k) != end(); }
+
+      iterator
+      lower_bound(const key_type& __k)
+      { return iterator(_M_lower_bound(__k)); }
+
+      const_iterator
+      lower_bound(const key_type& __k) const
+      { return const_iterator(_M_lower_bound(__k)); }
+
+      iterator
+      upper_bound(const key_type& __k)
+      { return iterator(_M_upper_bound(__k)); }
+
+      const_iterator
+      upper_bound(const key_type& __k) const
+      { return const_iterator(_M_upper_bound(__k)); }
+
+      std::pair<iterator, iterator>
+      equal_range(const key_type& __k)
+      {
+	iterator __i = find(__k);
+	iterator __j = __i;
+	return { __i, __i == end() ? __i : ++__j };
+      }
+
+      std::pair<const_iterator, const_iterator>
+      equal_range(const key_type& __k) const
+      {
+	const_iterator __i = find(__k);
+	const_iterator __j = __i;
+	return { __i, __i == end() ? __i : ++__j };
+      }
+
+    private:
+      _Base_ptr
+      _M_root() const noexcept
+      { return _M_impl._M_header._M_parent; }
+
+      _Base_ptr
+      _M_end() const noexcept
+      { return const_cast<_Base_ptr>(&_M_impl._M_header); }
+
+      iterator
+      _M_insert(bool __insert_left, _Base_ptr __z, _Base_ptr __p) noexcept
+      {
+	std::_Rb_tree_insert_and_rebalance(__insert_left, __z, __p,
+					   _M_impl._M_header);
+	++_M_impl._M_node_count;
+	return iterator(__z);
+      }
+
+      _Base_ptr
+      _M_lower_bound(const key_type& __k) const
+      {
+	_Base_ptr __x = _M_root();
+	_Base_ptr __y = _M_end();
+	while (__x != nullptr)
+	  if (!_M_impl._M_key_compare(_S_key(__x), __k))
+	    __y = __x, __x = __x->_M_left;
+	  else
+	    __x = __x->_M_right;
+	return __y;
+      }
+
+      _Base_ptr
+      _M_upper_bound(const key_type& __k) const
+      {
+	_Base_ptr __x = _M_root();
+	_Base_ptr __y = _M_end();
+	while (__x != nullptr)
+	  if (_M_impl._M_key_compare(__k, _S_key(__x)))
+	    __y = __x, __x = __x->_M_left;
+	  else
+	    __x = __x->_M_right;
+	return __y;
+      }
+
+      // Unlink the subtree rooted at __x without rebalancing.
+      static void
+      _S_clear(_Base_ptr __x) noexcept
+      {
+	while (__x != nullptr)
+	  {
+	    _S_clear(__x->_M_right);
+	    _Base_ptr __y = __x->_M_left;
+	    static_cast<iset_hook*>(__x)->_M_clear();
+	    __x = __y;
+	  }
+      }
+
+      _Impl _M_impl;
+    };
+
+  template<typename _Key, typename _Tp, iset_hook _Tp::* _Hook,
+	   typename _KeyOfValue, typename _Compare>
+    inline void
+    swap(__irb_tree<_Key, _Tp, _Hook, _KeyOfValue, _Compare>& __x,
+	 __irb_tree<_Key, _Tp, _Hook, _KeyOfValue, _Compare>& __y)
+    noexcept(noexcept(__x.swap(__y)))
+    { __x.swap(__y); }
+
+  /**
+   *  @brief An ordered set of objects linked through the member @a _Hook.
+   *
+   *  @tparam _Tp       Type of the elements, which are their own keys.
+   *  @tparam _Hook     Pointer to the iset_hook member of _Tp to link by.
+   *  @tparam _Compare  Comparison of elements, std::less<_Tp> by default.
+   */
+  template<typename _Tp, iset_hook _Tp::* _Hook,
+	   typename _Compare = std::less<_Tp>>
+    using iset = __irb_tree<_Tp, _Tp, _Hook, std::_Identity<_Tp>, _Compare>;
+
+  /**
+   *  @brief An ordered map of objects linked through the member @a _Hook
+   *  and keyed by their member @a _Member.
+   *
+   *  @tparam _Key      Type of the keys.
+   *  @tparam _Tp       Type of the elements.
+   *  @tparam _Hook     Pointer to the iset_hook member of _Tp to link by.
+   *  @tparam _Member   Pointer to the key member of _Tp.
+   *  @tparam _Compare  Comparison of keys, std::less<_Key> by default.
+   */
+  template<typename _Key, typename _Tp, iset_hook _Tp::* _Hook,
+	   _Key _Tp::* _Member, typename _Compare = std::less<_Key>>
+    using imap = __irb_tree<_Key, _Tp, _Hook,
+			    __key_member<_Key, _Tp, _Member>, _Compare>;
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++11
+
+#endif // _ISET_H
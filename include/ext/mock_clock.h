@@ -0,0 +1,66 @@
+// Host-side mock of the high resolution clock -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/mock_clock.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Controls the std::chrono::high_resolution_clock (and hence the
+ *  steady_clock alias) defined by src/chrono.cc when it is built with
+ *  MODM_CHRONO_MOCK, so that code using the clock can be run on a host.
+ */
+
+#ifndef _MOCK_CLOCK_H
+#define _MOCK_CLOCK_H 1
+
+#pragma GCC system_header
+
+#include <chrono>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Manual control of the mocked std::chrono::high_resolution_clock.
+  struct mock_clock
+  {
+    using clock = std::chrono::high_resolution_clock;
+
+    /// Make now() return @a __t.
+    static void
+    set(const clock::time_point& __t) noexcept;
+
+    /// Move the clock forward by @a __d.
+    static void
+    advance(const clock::duration& __d) noexcept;
+
+    /// Move the clock forward by @a __d after every call of now(), so
+    /// that busy-wait loops terminate.  The default step is zero.
+    static void
+    set_step(const clock::duration& __d) noexcept;
+  };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // _MOCK_CLOCK_H
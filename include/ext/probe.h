@@ -0,0 +1,237 @@
+// Scoped timing probes -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/probe.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Timing probes measuring code sections in std::chrono::cycle_clock
+ *  cycles.  Each named site accumulates the minimum, maximum, mean and
+ *  count of its measurements; all sites form a static table that can be
+ *  walked with probe_site::first() and probe_site::next().
+ *
+ *  @code
+ *  ISR(ADC_vect)
+ *  {
+ *    MODM_PROBE("adc isr");
+ *    // ...
+ *  }
+ *  @endcode
+ *
+ *  Probes are only active if MODM_PROBES is defined.  Otherwise
+ *  MODM_PROBE() expands to nothing and the classes below are empty, so
+ *  instrumentation can stay in place at no cost.
+ */
+
+#ifndef _PROBE_H
+#define _PROBE_H 1
+
+#pragma GCC system_header
+
+#include <chrono>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+#if defined(MODM_PROBES)
+
+  /**
+   *  @brief  Statistics of one instrumented code section.
+   *
+   *  A site links itself into the table when it is constructed, so it
+   *  should have static storage duration.  Sites are not synchronized;
+   *  a site must be recorded either only from one interrupt handler or
+   *  only from the main loop.
+   */
+  class probe_site
+  {
+  public:
+    using clock	   = std::chrono::cycle_clock;
+    using duration = clock::duration;
+
+    explicit
+    probe_site(const char* __name) noexcept
+    : _M_name(__name), _M_next(_S_head)
+    { _S_head = this; }
+
+    probe_site(const probe_site&) = delete;
+    probe_site& operator=(const probe_site&) = delete;
+
+    void
+    record(duration __d) noexcept
+    {
+      const duration::rep __c = __d.count();
+      if (_M_count == 0 || __c < _M_min)
+	_M_min = __c;
+      if (__c > _M_max)
+	_M_max = __c;
+      _M_total += __c;
+      ++_M_count;
+    }
+
+    void
+    reset() noexcept
+    {
+      _M_min = _M_max = 0;
+      _M_total = 0;
+      _M_count = 0;
+    }
+
+    const char*
+    name() const noexcept
+    { return _M_name; }
+
+    std::uint32_t
+    count() const noexcept
+    { return _M_count; }
+
+    duration
+    min() const noexcept
+    { return duration(_M_min); }
+
+    duration
+    max() const noexcept
+    { return duration(_M_max); }
+
+    duration
+    mean() const noexcept
+    {
+      return duration(_M_count == 0 ? 0
+		      : static_cast<duration::rep>(_M_total / _M_count));
+    }
+
+    static probe_site*
+    first() noexcept
+    { return _S_head; }
+
+    probe_site*
+    next() const noexcept
+    { return _M_next; }
+
+  private:
+    const char*	  _M_name;
+    probe_site*	  _M_next;
+    duration::rep _M_min = 0;
+    duration::rep _M_max = 0;
+    std::uint64_t _M_total = 0;
+    std::uint32_t _M_count = 0;
+
+    static inline probe_site* _S_head = nullptr;
+  };
+
+  /// Measures the lifetime of this object and records it into a site.
+  class scoped_probe
+  {
+  public:
+    explicit
+    scoped_probe(probe_site& __site) noexcept
+    : _M_site(__site), _M_start(probe_site::clock::now())
+    { }
+
+    scoped_probe(const scoped_probe&) = delete;
+    scoped_probe& operator=(const scoped_probe&) = delete;
+
+    ~scoped_probe()
+    { _M_site.record(probe_site::clock::now() - _M_start); }
+
+  private:
+    probe_site&			    _M_site;
+    probe_site::clock::time_point _M_start;
+  };
+
+#define _MODM_PROBE_CAT2(a, b) a ## b
+#define _MODM_PROBE_CAT(a, b) _MODM_PROBE_CAT2(a, b)
+
+/// Time the rest of the enclosing scope as the site named @a name.
+#define MODM_PROBE(name) \
+  static ::__gnu_cxx::probe_site _MODM_PROBE_CAT(__modm_site_, __LINE__)(name); \
+  const ::__gnu_cxx::scoped_probe _MODM_PROBE_CAT(__modm_probe_, __LINE__) \
+    (_MODM_PROBE_CAT(__modm_site_, __LINE__))
+
+#else // !MODM_PROBES
+
+  // Disabled probes: same interface, no state and no clock reads.
+  class probe_site
+  {
+  public:
+    using clock	   = std::chrono::cycle_clock;
+    using duration = clock::duration;
+
+    explicit constexpr
+    probe_site(const char*) noexcept
+    { }
+
+    void
+    record(duration) noexcept
+    { }
+
+    void
+    reset() noexcept
+    { }
+
+    const char*
+    name() const noexcept
+    { return ""; }
+
+    std::uint32_t
+    count() const noexcept
+    { return 0; }
+
+    duration
+    min() const noexcept
+    { return duration::zero(); }
+
+    duration
+    max() const noexcept
+    { return duration::zero(); }
+
+    duration
+    mean() const noexcept
+    { return duration::zero(); }
+
+    static probe_site*
+    first() noexcept
+    { return nullptr; }
+
+    probe_site*
+    next() const noexcept
+    { return nullptr; }
+  };
+
+  class scoped_probe
+  {
+  public:
+    explicit
+    scoped_probe(probe_site&) noexcept
+    { }
+  };
+
+#define MODM_PROBE(name) static_cast<void>(0)
+
+#endif // MODM_PROBES
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // _PROBE_H
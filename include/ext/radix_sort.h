@@ -0,0 +1,425 @@
+// Radix and counting sort for integral keys -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/radix_sort.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Stable sorting by integral keys without comparisons, in the style of
+ *  the C++20 range algorithms.
+ *
+ *  __gnu_cxx::ranges::counting_sort sorts by a key of at most 8 bits in
+ *  a single counting pass.  __gnu_cxx::ranges::radix_sort sorts by wider
+ *  keys with one least-significant-digit counting pass per digit of
+ *  MODM_RADIX_SORT_BITS bits (default 8); passes in which all keys share
+ *  the digit are skipped.  Both are stable, take a projection to sort
+ *  records by a key member, and accept signed keys.
+ *
+ *  @code
+ *  struct sample { std::uint16_t value; std::uint8_t channel; };
+ *  std::array<sample, 64> __s;
+ *  std::array<sample, 64> __scratch;
+ *  __gnu_cxx::ranges::radix_sort(__s, __scratch, &sample::value);
+ *  @endcode
+ *
+ *  Each pass moves the elements into a scratch buffer of at least as many
+ *  elements and back.  The buffer can be given as a second range, whose
+ *  elements must be constructed and are left in a valid but unspecified
+ *  state; otherwise a temporary buffer is allocated, and if that fails
+ *  (or the given buffer is too small) the range is sorted by
+ *  std::ranges::stable_sort instead.  A range of integers of at most 8
+ *  bits that is sorted by its own values needs no buffer at all: the
+ *  values are counted and written back.
+ *
+ *  Fewer than 16 elements are sorted by insertion sort instead.  The
+ *  digit counts are kept on the stack, 2^MODM_RADIX_SORT_BITS of them
+ *  of the range's difference type (512 bytes on AVR with 8-bit digits).
+ *  A value of 4 reduces that to 32 bytes at the cost of twice as many
+ *  passes.
+ */
+
+#ifndef _RADIX_SORT_H
+#define _RADIX_SORT_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus > 201703L
+
+#include <algorithm>
+#include <bits/stl_tempbuf.h>
+#include <limits>
+#include <type_traits>
+
+#if !defined(MODM_RADIX_SORT_BITS)
+#define MODM_RADIX_SORT_BITS 8
+#endif
+
+#if __cpp_lib_concepts
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace ranges
+{
+  namespace __detail
+  {
+    template<typename _Iter, typename _Proj>
+      using __radix_key_t
+	= std::remove_cvref_t<std::indirect_result_t<_Proj&, _Iter>>;
+
+    template<typename _Iter, typename _Proj>
+      concept __radix_sortable = std::random_access_iterator<_Iter>
+	&& std::indirectly_movable_storable<_Iter, _Iter>
+	&& std::indirectly_readable<std::projected<_Iter, _Proj>>
+	&& std::integral<__radix_key_t<_Iter, _Proj>>
+	&& !std::same_as<__radix_key_t<_Iter, _Proj>, bool>;
+
+    // A buffer to move the elements of _Iter into and back.
+    template<typename _Buf, typename _Iter>
+      concept __radix_buffer = std::ranges::random_access_range<_Buf>
+	&& std::ranges::sized_range<_Buf>
+	&& std::indirectly_movable<_Iter, std::ranges::iterator_t<_Buf>>
+	&& std::indirectly_movable<std::ranges::iterator_t<_Buf>, _Iter>;
+
+    // The key as an unsigned integer of the same width, in the same
+    // order: the sign bit of signed keys is flipped.
+    template<std::integral _Key>
+      constexpr std::make_unsigned_t<_Key>
+      __radix_key(_Key __k) noexcept
+      {
+	using _Up = std::make_unsigned_t<_Key>;
+	_Up __u = static_cast<_Up>(__k);
+	if constexpr (std::is_signed_v<_Key>)
+	  __u ^= static_cast<_Up>(_Up(1) << (std::numeric_limits<_Up>::digits
+					     - 1));
+	return __u;
+      }
+
+    // One stable counting pass that moves the __n elements at __in to
+    // __out, ordered by the digit of _Bits bits at __shift.  Does nothing
+    // and returns false if all elements have the same digit.
+    template<unsigned _Bits, typename _In, typename _Out, typename _Proj>
+      bool
+      __counting_pass(_In __in, std::iter_difference_t<_In> __n, _Out __out,
+		      _Proj& __proj, unsigned __shift)
+      {
+	using _Diff = std::iter_difference_t<_In>;
+	constexpr unsigned __radix = 1U << _Bits;
+	constexpr unsigned __mask = __radix - 1U;
+
+	auto __digit = [&__proj, __shift] (auto&& __x) -> unsigned {
+	  return static_cast<unsigned>(__detail::__radix_key(
+	      std::__invoke(__proj, std::forward<decltype(__x)>(__x)))
+	    >> __shift) & __mask;
+	};
+
+	_Diff __count[__radix] = { };
+	for (_Diff __i = 0; __i < __n; ++__i)
+	  ++__count[__digit(__in[__i])];
+
+	if (__count[__digit(__in[0])] == __n)
+	  return false;
+
+	_Diff __sum = 0;
+	for (unsigned __b = 0; __b < __radix; ++__b)
+	  {
+	    const _Diff __c = __count[__b];
+	    __count[__b] = __sum;
+	    __sum += __c;
+	  }
+
+	for (_Diff __i = 0; __i < __n; ++__i)
+	  __out[__count[__digit(__in[__i])]++]
+	    = std::ranges::iter_move(__in + __i);
+	return true;
+      }
+
+    // Below this many elements, the digit counts cost more than a stable
+    // insertion sort.
+    inline constexpr int __radix_sort_threshold = 16;
+
+    template<typename _Iter, typename _Proj>
+      void
+      __insertion_sort(_Iter __first, std::iter_difference_t<_Iter> __n,
+		       _Proj& __proj)
+      {
+	std::ranges::less __less;
+	std::__insertion_sort(__first, __first + __n,
+			      __gnu_cxx::__ops::__iter_comp_iter(
+				std::ranges::__detail::__make_comp_proj(__less,
+									__proj)));
+      }
+
+    // Sort the __n elements at __first by the key __proj, using the
+    // buffer at __buf, with one pass per digit of _Bits bits.
+    template<unsigned _Bits, typename _Iter, typename _Buf, typename _Proj>
+      void
+      __radix_sort(_Iter __first, std::iter_difference_t<_Iter> __n,
+		   _Buf __buf, _Proj& __proj)
+      {
+	using _Key = __radix_key_t<_Iter, _Proj>;
+	constexpr unsigned __bits = std::numeric_limits<
+	  std::make_unsigned_t<_Key>>::digits;
+
+	if (__n < __radix_sort_threshold)
+	  {
+	    __detail::__insertion_sort(__first, __n, __proj);
+	    return;
+	  }
+
+	bool __in_buffer = false;
+	for (unsigned __shift = 0; __shift < __bits; __shift += _Bits)
+	  {
+	    if (!__in_buffer)
+	      __in_buffer = __detail::__counting_pass<_Bits>(__first, __n,
+							     __buf, __proj,
+							     __shift);
+	    else
+	      __in_buffer = !__detail::__counting_pass<_Bits>(__buf, __n,
+							      __first, __proj,
+							      __shift);
+	  }
+
+	if (__in_buffer)
+	  std::ranges::move(__buf, __buf + __n, __first);
+      }
+
+    // Sort integers of at most 8 bits by their values, in place.
+    template<typename _Iter>
+      void
+      __counting_fill(_Iter __first, std::iter_difference_t<_Iter> __n)
+      {
+	using _Diff = std::iter_difference_t<_Iter>;
+	using _Key = std::iter_value_t<_Iter>;
+	using _Up = std::make_unsigned_t<_Key>;
+	constexpr unsigned __radix = 1U << std::numeric_limits<_Up>::digits;
+
+	if (__n < __radix_sort_threshold)
+	  {
+	    std::identity __proj;
+	    __detail::__insertion_sort(__first, __n, __proj);
+	    return;
+	  }
+
+	_Diff __count[__radix] = { };
+	for (_Diff __i = 0; __i < __n; ++__i)
+	  ++__count[__detail::__radix_key(static_cast<_Key>(__first[__i]))];
+
+	for (unsigned __b = 0; __b < __radix; ++__b)
+	  {
+	    // The value whose __radix_key is __b.
+	    const _Key __v = static_cast<_Key>(
+		__detail::__radix_key(static_cast<_Key>(__b)));
+	    for (_Diff __c = __count[__b]; __c > 0; --__c)
+	      *__first++ = __v;
+	  }
+      }
+
+    template<typename _Iter, typename _Proj>
+      constexpr bool __sorts_by_value
+	= std::same_as<_Proj, std::identity>
+	  && std::same_as<std::iter_value_t<_Iter>, __radix_key_t<_Iter, _Proj>>
+	  && std::is_assignable_v<std::iter_reference_t<_Iter>,
+				  std::iter_value_t<_Iter>>;
+
+    template<unsigned _Bits, typename _Iter, typename _Proj>
+      void
+      __radix_sort_with_temporary(_Iter __first, _Iter __last, _Proj& __proj)
+      {
+	const auto __n = __last - __first;
+	if (__n < __radix_sort_threshold)
+	  {
+	    __detail::__insertion_sort(__first, __n, __proj);
+	    return;
+	  }
+
+	std::_Temporary_buffer<_Iter, std::iter_value_t<_Iter>>
+	  __buf(__first, __n);
+	if (__buf.size() == __n)
+	  __detail::__radix_sort<_Bits>(__first, __n, __buf.begin(), __proj);
+	else
+	  std::ranges::stable_sort(__first, __last, {}, __proj);
+      }
+  } // namespace __detail
+
+  struct __counting_sort_fn
+  {
+    template<std::random_access_iterator _Iter, std::sized_sentinel_for<_Iter> _Sent,
+	     typename _Proj = std::identity>
+      requires __detail::__radix_sortable<_Iter, _Proj>
+      _Iter
+      operator()(_Iter __first, _Sent __last, _Proj __proj = {}) const
+      {
+	using _Key = __detail::__radix_key_t<_Iter, _Proj>;
+	static_assert(std::numeric_limits<std::make_unsigned_t<_Key>>::digits
+		      <= 8, "counting_sort needs a key of at most 8 bits");
+
+	auto __lasti = std::ranges::next(__first, __last);
+	const auto __n = __lasti - __first;
+	if (__n < 2)
+	  return __lasti;
+
+	if constexpr (__detail::__sorts_by_value<_Iter, _Proj>)
+	  __detail::__counting_fill(__first, __n);
+	else
+	  __detail::__radix_sort_with_temporary<8>(__first, __lasti, __proj);
+	return __lasti;
+      }
+
+    template<std::random_access_iterator _Iter, std::sized_sentinel_for<_Iter> _Sent,
+	     typename _Buf, typename _Proj = std::identity>
+      requires __detail::__radix_sortable<_Iter, _Proj>
+	&& __detail::__radix_buffer<_Buf, _Iter>
+      _Iter
+      operator()(_Iter __first, _Sent __last, _Buf&& __buf,
+		 _Proj __proj = {}) const
+      {
+	using _Key = __detail::__radix_key_t<_Iter, _Proj>;
+	static_assert(std::numeric_limits<std::make_unsigned_t<_Key>>::digits
+		      <= 8, "counting_sort needs a key of at most 8 bits");
+
+	auto __lasti = std::ranges::next(__first, __last);
+	const auto __n = __lasti - __first;
+	if (__n < 2)
+	  return __lasti;
+
+	if constexpr (__detail::__sorts_by_value<_Iter, _Proj>)
+	  __detail::__counting_fill(__first, __n);
+	else if (std::ranges::distance(__buf) >= __n)
+	  __detail::__radix_sort<8>(__first, __n, std::ranges::begin(__buf),
+				    __proj);
+	else
+	  std::ranges::stable_sort(__first, __lasti, {}, __proj);
+	return __lasti;
+      }
+
+    template<std::ranges::random_access_range _Range,
+	     typename _Proj = std::identity>
+      requires std::ranges::sized_range<_Range>
+	&& __detail::__radix_sortable<std::ranges::iterator_t<_Range>, _Proj>
+      std::ranges::borrowed_iterator_t<_Range>
+      operator()(_Range&& __r, _Proj __proj = {}) const
+      {
+	return (*this)(std::ranges::begin(__r), std::ranges::end(__r),
+		       std::move(__proj));
+      }
+
+    template<std::ranges::random_access_range _Range, typename _Buf,
+	     typename _Proj = std::identity>
+      requires std::ranges::sized_range<_Range>
+	&& __detail::__radix_sortable<std::ranges::iterator_t<_Range>, _Proj>
+	&& __detail::__radix_buffer<_Buf, std::ranges::iterator_t<_Range>>
+      std::ranges::borrowed_iterator_t<_Range>
+      operator()(_Range&& __r, _Buf&& __buf, _Proj __proj = {}) const
+      {
+	return (*this)(std::ranges::begin(__r), std::ranges::end(__r),
+		       std::forward<_Buf>(__buf), std::move(__proj));
+      }
+  };
+
+  /// Stable sort by a key of at most 8 bits, in one counting pass.
+  inline constexpr __counting_sort_fn counting_sort{};
+
+  struct __radix_sort_fn
+  {
+    template<std::random_access_iterator _Iter, std::sized_sentinel_for<_Iter> _Sent,
+	     typename _Proj = std::identity>
+      requires __detail::__radix_sortable<_Iter, _Proj>
+      _Iter
+      operator()(_Iter __first, _Sent __last, _Proj __proj = {}) const
+      {
+	using _Key = __detail::__radix_key_t<_Iter, _Proj>;
+	if constexpr (sizeof(_Key) == 1)
+	  return counting_sort(std::move(__first), std::move(__last),
+			       std::move(__proj));
+	else
+	  {
+	    auto __lasti = std::ranges::next(__first, __last);
+	    if (__lasti - __first >= 2)
+	      __detail::__radix_sort_with_temporary<MODM_RADIX_SORT_BITS>(
+		  __first, __lasti, __proj);
+	    return __lasti;
+	  }
+      }
+
+    template<std::random_access_iterator _Iter, std::sized_sentinel_for<_Iter> _Sent,
+	     typename _Buf, typename _Proj = std::identity>
+      requires __detail::__radix_sortable<_Iter, _Proj>
+	&& __detail::__radix_buffer<_Buf, _Iter>
+      _Iter
+      operator()(_Iter __first, _Sent __last, _Buf&& __buf,
+		 _Proj __proj = {}) const
+      {
+	using _Key = __detail::__radix_key_t<_Iter, _Proj>;
+	if constexpr (sizeof(_Key) == 1)
+	  return counting_sort(std::move(__first), std::move(__last),
+			       std::forward<_Buf>(__buf), std::move(__proj));
+	else
+	  {
+	    auto __lasti = std::ranges::next(__first, __last);
+	    const auto __n = __lasti - __first;
+	    if (__n < 2)
+	      return __lasti;
+
+	    if (std::ranges::distance(__buf) >= __n)
+	      __detail::__radix_sort<MODM_RADIX_SORT_BITS>(
+		  __first, __n, std::ranges::begin(__buf), __proj);
+	    else
+	      std::ranges::stable_sort(__first, __lasti, {}, __proj);
+	    return __lasti;
+	  }
+      }
+
+    template<std::ranges::random_access_range _Range,
+	     typename _Proj = std::identity>
+      requires std::ranges::sized_range<_Range>
+	&& __detail::__radix_sortable<std::ranges::iterator_t<_Range>, _Proj>
+      std::ranges::borrowed_iterator_t<_Range>
+      operator()(_Range&& __r, _Proj __proj = {}) const
+      {
+	return (*this)(std::ranges::begin(__r), std::ranges::end(__r),
+		       std::move(__proj));
+      }
+
+    template<std::ranges::random_access_range _Range, typename _Buf,
+	     typename _Proj = std::identity>
+      requires std::ranges::sized_range<_Range>
+	&& __detail::__radix_sortable<std::ranges::iterator_t<_Range>, _Proj>
+	&& __detail::__radix_buffer<_Buf, std::ranges::iterator_t<_Range>>
+      std::ranges::borrowed_iterator_t<_Range>
+      operator()(_Range&& __r, _Buf&& __buf, _Proj __proj = {}) const
+      {
+	return (*this)(std::ranges::begin(__r), std::ranges::end(__r),
+		       std::forward<_Buf>(__buf), std::move(__proj));
+      }
+  };
+
+  /// Stable LSD radix sort by an integral key.
+  inline constexpr __radix_sort_fn radix_sort{};
+} // namespace ranges
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+#endif // concepts
+
+#endif // C++20
+
+#endif // _RADIX_SORT_H
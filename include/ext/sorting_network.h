@@ -0,0 +1,458 @@
+// Sorting networks for small fixed sizes -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/sorting_network.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Sorting and median selection of a number of elements known at compile
+ *  time, by sorting networks.  A network is a fixed sequence of
+ *  compare-exchange steps that is unrolled into straight-line code: there
+ *  are no loops and no data-dependent control flow apart from the
+ *  compare-exchanges themselves, so the cycle count barely depends on the
+ *  input.  This suits median filters and other small sorts in interrupt
+ *  handlers.
+ *
+ *  @code
+ *  std::array<std::uint16_t, 5> __samples = read_adc();
+ *  std::uint16_t __filtered = *__gnu_cxx::median_n(__samples);
+ *  @endcode
+ *
+ *  The networks for 2 to 12 elements and for 14 to 16 elements use the
+ *  least number of compare-exchanges known (1, 3, 5, 9, 12, 16, 19, 25,
+ *  29, 35, 39, 51, 56, 60); 13 elements take 46, one more than the best
+ *  known.  Larger sizes fall back to std::sort and std::nth_element.
+ */
+
+#ifndef _SORTING_NETWORK_H
+#define _SORTING_NETWORK_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201402L
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <utility>
+#if __cplusplus > 201703L
+#include <span>
+#endif
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // Compare-exchange step: afterwards *(__first + _Lo) is not greater
+  // than *(__first + _Hi) under __comp.  Both values are loaded and
+  // stored unconditionally, so the compiler can select rather than
+  // branch where the target allows it.
+  template<unsigned _Lo, unsigned _Hi, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __compare_exchange(_RandomAccessIterator __first, _Compare& __comp)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+	_ValueType;
+      _ValueType __lo = std::move(*(__first + _Lo));
+      _ValueType __hi = std::move(*(__first + _Hi));
+      const bool __swap = __comp(__hi, __lo);
+      *(__first + _Lo) = std::move(__swap ? __hi : __lo);
+      *(__first + _Hi) = std::move(__swap ? __lo : __hi);
+    }
+
+  template<typename _Network, typename _RandomAccessIterator,
+	   typename _Compare, std::size_t... _Is>
+    inline void
+    __apply_network(_RandomAccessIterator __first, _Compare& __comp,
+		    std::index_sequence<_Is...>)
+    {
+      const int __steps[] = { 0,
+	(__gnu_cxx::__compare_exchange<_Network::_S_cmp[_Is][0],
+				       _Network::_S_cmp[_Is][1]>(__first,
+								 __comp),
+	 0)... };
+      (void) __steps;
+    }
+
+  template<typename _Network, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __apply_network(_RandomAccessIterator __first, _Compare& __comp)
+    {
+      __gnu_cxx::__apply_network<_Network>(__first, __comp,
+	std::make_index_sequence<sizeof(_Network::_S_cmp)
+				 / sizeof(_Network::_S_cmp[0])>());
+    }
+
+  // Sorting networks, as pairs of positions to compare-exchange in order.
+  // Each of them sorts all 2^N sequences of zeros and ones, and hence
+  // every input.
+  template<std::size_t _Nm>
+    struct __sorting_network;
+
+  template<>
+    struct __sorting_network<2>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 1}
+      };
+    };
+
+  template<>
+    struct __sorting_network<3>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 2}, {0, 1}, {1, 2}
+      };
+    };
+
+  template<>
+    struct __sorting_network<4>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 2}, {1, 3}, {0, 1}, {2, 3}, {1, 2}
+      };
+    };
+
+  template<>
+    struct __sorting_network<5>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1}, {2, 4}, {1, 2}, {3, 4}, {2, 3}
+      };
+    };
+
+  template<>
+    struct __sorting_network<6>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3}, {2, 5}, {0, 1}, {2, 3},
+	{4, 5}, {1, 2}, {3, 4}
+      };
+    };
+
+  template<>
+    struct __sorting_network<7>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6}, {0, 1}, {2, 5}, {3, 4},
+	{1, 2}, {4, 6}, {2, 3}, {4, 5}, {1, 2}, {3, 4}, {5, 6}
+      };
+    };
+
+  template<>
+    struct __sorting_network<8>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1},
+	{2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4},
+	{5, 6}
+      };
+    };
+
+  template<>
+    struct __sorting_network<9>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 3}, {1, 7}, {2, 5}, {4, 8}, {0, 7}, {2, 4}, {3, 8}, {5, 6}, {0, 2},
+	{1, 3}, {4, 5}, {7, 8}, {1, 4}, {3, 6}, {5, 7}, {0, 1}, {2, 4}, {3, 5},
+	{6, 8}, {2, 3}, {4, 5}, {6, 7}, {1, 2}, {3, 4}, {5, 6}
+      };
+    };
+
+  template<>
+    struct __sorting_network<10>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 8}, {1, 9}, {2, 7}, {3, 5}, {4, 6}, {0, 2}, {1, 4}, {5, 8}, {7, 9},
+	{0, 3}, {2, 4}, {5, 7}, {6, 9}, {0, 1}, {3, 6}, {8, 9}, {1, 5}, {2, 3},
+	{4, 8}, {6, 7}, {1, 2}, {3, 5}, {4, 6}, {7, 8}, {2, 3}, {4, 5}, {6, 7},
+	{3, 4}, {5, 6}
+      };
+    };
+
+  template<>
+    struct __sorting_network<11>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 8}, {1, 7}, {2, 6}, {4, 10}, {5, 9}, {0, 1}, {2, 5}, {3, 4},
+	{6, 9}, {7, 8}, {0, 2}, {1, 6}, {5, 10}, {0, 3}, {1, 2}, {4, 6},
+	{5, 7}, {9, 10}, {1, 4}, {3, 5}, {6, 8}, {7, 10}, {1, 3}, {2, 5},
+	{6, 9}, {8, 10}, {2, 3}, {4, 5}, {6, 7}, {8, 9}, {4, 6}, {5, 7},
+	{3, 4}, {5, 6}, {7, 8}
+      };
+    };
+
+  template<>
+    struct __sorting_network<12>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 8}, {1, 7}, {2, 6}, {3, 11}, {4, 10}, {5, 9}, {0, 1}, {2, 5},
+	{3, 4}, {6, 9}, {7, 8}, {10, 11}, {0, 2}, {1, 6}, {5, 10}, {9, 11},
+	{0, 3}, {1, 2}, {4, 6}, {5, 7}, {8, 11}, {9, 10}, {1, 4}, {3, 5},
+	{6, 8}, {7, 10}, {1, 3}, {2, 5}, {6, 9}, {8, 10}, {2, 3}, {4, 5},
+	{6, 7}, {8, 9}, {4, 6}, {5, 7}, {3, 4}, {5, 6}, {7, 8}
+      };
+    };
+
+  template<>
+    struct __sorting_network<13>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{1, 12}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5}, {1, 7}, {2, 9},
+	{3, 4}, {11, 12}, {0, 1}, {2, 3}, {4, 5}, {6, 8}, {7, 9}, {10, 11},
+	{0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7}, {8, 9}, {1, 2}, {3, 12},
+	{4, 6}, {5, 7}, {8, 10}, {9, 11}, {1, 4}, {2, 6}, {5, 8}, {7, 10},
+	{2, 4}, {3, 6}, {9, 12}, {3, 5}, {6, 8}, {7, 9}, {10, 12}, {3, 4},
+	{5, 6}, {7, 8}, {9, 10}, {11, 12}, {6, 7}, {8, 9}
+      };
+    };
+
+  template<>
+    struct __sorting_network<14>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 13}, {1, 12}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5}, {1, 7},
+	{2, 9}, {3, 4}, {6, 13}, {11, 12}, {0, 1}, {2, 3}, {4, 5}, {6, 8},
+	{7, 9}, {10, 11}, {12, 13}, {0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7},
+	{8, 9}, {1, 2}, {3, 12}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {1, 4},
+	{2, 6}, {5, 8}, {7, 10}, {9, 13}, {2, 4}, {3, 6}, {9, 12}, {11, 13},
+	{3, 5}, {6, 8}, {7, 9}, {10, 12}, {3, 4}, {5, 6}, {7, 8}, {9, 10},
+	{11, 12}, {6, 7}, {8, 9}
+      };
+    };
+
+  template<>
+    struct __sorting_network<15>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 13}, {1, 12}, {3, 14}, {4, 8}, {5, 6}, {7, 11}, {9, 10}, {0, 5},
+	{1, 7}, {2, 9}, {3, 4}, {6, 13}, {8, 14}, {11, 12}, {0, 1}, {2, 3},
+	{4, 5}, {6, 8}, {7, 9}, {10, 11}, {12, 13}, {0, 2}, {1, 3}, {4, 10},
+	{5, 11}, {6, 7}, {8, 9}, {12, 14}, {1, 2}, {3, 12}, {4, 6}, {5, 7},
+	{8, 10}, {9, 11}, {13, 14}, {1, 4}, {2, 6}, {5, 8}, {7, 10}, {9, 13},
+	{11, 14}, {2, 4}, {3, 6}, {9, 12}, {11, 13}, {3, 5}, {6, 8}, {7, 9},
+	{10, 12}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {6, 7}, {8, 9}
+      };
+    };
+
+  template<>
+    struct __sorting_network<16>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 13}, {1, 12}, {2, 15}, {3, 14}, {4, 8}, {5, 6}, {7, 11}, {9, 10},
+	{0, 5}, {1, 7}, {2, 9}, {3, 4}, {6, 13}, {8, 14}, {10, 15}, {11, 12},
+	{0, 1}, {2, 3}, {4, 5}, {6, 8}, {7, 9}, {10, 11}, {12, 13}, {14, 15},
+	{0, 2}, {1, 3}, {4, 10}, {5, 11}, {6, 7}, {8, 9}, {12, 14}, {13, 15},
+	{1, 2}, {3, 12}, {4, 6}, {5, 7}, {8, 10}, {9, 11}, {13, 14}, {1, 4},
+	{2, 6}, {5, 8}, {7, 10}, {9, 13}, {11, 14}, {2, 4}, {3, 6}, {9, 12},
+	{11, 13}, {3, 5}, {6, 8}, {7, 9}, {10, 12}, {3, 4}, {5, 6}, {7, 8},
+	{9, 10}, {11, 12}, {6, 7}, {8, 9}
+      };
+    };
+
+  // Median selection networks, which only guarantee that the median ends
+  // up in the middle position.  The other sizes use a sorting network.
+  template<std::size_t _Nm>
+    struct __median_network
+    : __sorting_network<_Nm>
+    { };
+
+  template<>
+    struct __median_network<3>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 1}, {1, 2}, {0, 1}
+      };
+    };
+
+  template<>
+    struct __median_network<5>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{0, 1}, {3, 4}, {0, 3}, {1, 4}, {1, 2}, {2, 3}, {1, 2}
+      };
+    };
+
+  // After A. W. Paeth, "Median finding on a 3x3 grid", Graphics Gems (1990).
+  template<>
+    struct __median_network<9>
+    {
+      static constexpr unsigned char _S_cmp[][2] = {
+	{1, 2}, {4, 5}, {7, 8}, {0, 1}, {3, 4}, {6, 7}, {1, 2}, {4, 5},
+	{7, 8}, {0, 3}, {5, 8}, {4, 7}, {3, 6}, {1, 4}, {2, 5}, {4, 7},
+	{4, 2}, {6, 4}, {4, 2}
+      };
+    };
+
+  // 0: nothing to do, 1: use a network, 2: too large for the networks.
+  template<std::size_t _Nm>
+    using __network_kind
+      = std::integral_constant<int, _Nm < 2 ? 0 : _Nm <= 16 ? 1 : 2>;
+
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __sort_n(_RandomAccessIterator, _Compare&, std::integral_constant<int, 0>)
+    { }
+
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __sort_n(_RandomAccessIterator __first, _Compare& __comp,
+	     std::integral_constant<int, 1>)
+    { __gnu_cxx::__apply_network<__sorting_network<_Nm>>(__first, __comp); }
+
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __sort_n(_RandomAccessIterator __first, _Compare& __comp,
+	     std::integral_constant<int, 2>)
+    { std::sort(__first, __first + _Nm, __comp); }
+
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __median_n(_RandomAccessIterator, _Compare&, std::integral_constant<int, 0>)
+    { }
+
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __median_n(_RandomAccessIterator __first, _Compare& __comp,
+	       std::integral_constant<int, 1>)
+    { __gnu_cxx::__apply_network<__median_network<_Nm>>(__first, __comp); }
+
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    __median_n(_RandomAccessIterator __first, _Compare& __comp,
+	       std::integral_constant<int, 2>)
+    { std::nth_element(__first, __first + _Nm / 2, __first + _Nm, __comp); }
+
+  /**
+   *  @brief Sort the @a _Nm elements starting at @a __first.
+   *  @param  __first  An iterator.
+   *  @param  __comp   A comparison functor.
+   *
+   *  Equivalent to std::sort(__first, __first + _Nm, __comp), but by a
+   *  sorting network for up to 16 elements.  Like std::sort, the sort is
+   *  not stable.
+  */
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline void
+    sort_n(_RandomAccessIterator __first, _Compare __comp)
+    {
+      __gnu_cxx::__sort_n<_Nm>(__first, __comp, __network_kind<_Nm>());
+    }
+
+  /// Sort the @a _Nm elements starting at @a __first in ascending order.
+  template<std::size_t _Nm, typename _RandomAccessIterator>
+    inline void
+    sort_n(_RandomAccessIterator __first)
+    { __gnu_cxx::sort_n<_Nm>(__first, std::less<>()); }
+
+  /// Sort an array by a sorting network.
+  template<typename _Tp, std::size_t _Nm, typename _Compare>
+    inline void
+    sort_n(std::array<_Tp, _Nm>& __a, _Compare __comp)
+    { __gnu_cxx::sort_n<_Nm>(__a.begin(), __comp); }
+
+  template<typename _Tp, std::size_t _Nm>
+    inline void
+    sort_n(std::array<_Tp, _Nm>& __a)
+    { __gnu_cxx::sort_n<_Nm>(__a.begin(), std::less<>()); }
+
+  /**
+   *  @brief Find the median of the @a _Nm elements starting at @a __first.
+   *  @param  __first  An iterator.
+   *  @param  __comp   A comparison functor.
+   *  @return  @a __first + _Nm / 2, which then refers to the median.
+   *
+   *  The elements are permuted so that the element at @a __first + _Nm / 2
+   *  is the one that would be there if the range were sorted.  Unlike
+   *  std::nth_element, the others are not partitioned around it; use
+   *  sort_n() if they need to be.  3, 5 and 9 elements use dedicated
+   *  median networks of 3, 7 and 19 compare-exchanges.
+  */
+  template<std::size_t _Nm, typename _RandomAccessIterator,
+	   typename _Compare>
+    inline _RandomAccessIterator
+    median_n(_RandomAccessIterator __first, _Compare __comp)
+    {
+      static_assert(_Nm > 0, "the median of no elements is undefined");
+      __gnu_cxx::__median_n<_Nm>(__first, __comp, __network_kind<_Nm>());
+      return __first + _Nm / 2;
+    }
+
+  template<std::size_t _Nm, typename _RandomAccessIterator>
+    inline _RandomAccessIterator
+    median_n(_RandomAccessIterator __first)
+    { return __gnu_cxx::median_n<_Nm>(__first, std::less<>()); }
+
+  template<typename _Tp, std::size_t _Nm, typename _Compare>
+    inline typename std::array<_Tp, _Nm>::iterator
+    median_n(std::array<_Tp, _Nm>& __a, _Compare __comp)
+    { return __gnu_cxx::median_n<_Nm>(__a.begin(), __comp); }
+
+  template<typename _Tp, std::size_t _Nm>
+    inline typename std::array<_Tp, _Nm>::iterator
+    median_n(std::array<_Tp, _Nm>& __a)
+    { return __gnu_cxx::median_n<_Nm>(__a.begin(), std::less<>()); }
+
+#if __cplusplus > 201703L
+  /// Sort a span of static extent by a sorting network.
+  template<typename _Tp, std::size_t _Nm, typename _Compare>
+    requires (_Nm != std::dynamic_extent)
+    inline void
+    sort_n(std::span<_Tp, _Nm> __s, _Compare __comp)
+    { __gnu_cxx::sort_n<_Nm>(__s.begin(), __comp); }
+
+  template<typename _Tp, std::size_t _Nm>
+    requires (_Nm != std::dynamic_extent)
+    inline void
+    sort_n(std::span<_Tp, _Nm> __s)
+    { __gnu_cxx::sort_n<_Nm>(__s.begin(), std::less<>()); }
+
+  template<typename _Tp, std::size_t _Nm, typename _Compare>
+    requires (_Nm != std::dynamic_extent)
+    inline typename std::span<_Tp, _Nm>::iterator
+    median_n(std::span<_Tp, _Nm> __s, _Compare __comp)
+    { return __gnu_cxx::median_n<_Nm>(__s.begin(), __comp); }
+
+  template<typename _Tp, std::size_t _Nm>
+    requires (_Nm != std::dynamic_extent)
+    inline typename std::span<_Tp, _Nm>::iterator
+    median_n(std::span<_Tp, _Nm> __s)
+    { return __gnu_cxx::median_n<_Nm>(__s.begin(), std::less<>()); }
+#endif // C++20
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // C++14
+
+#endif // _SORTING_NETWORK_H
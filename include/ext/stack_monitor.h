@@ -0,0 +1,112 @@
+// Stack painting and high-water measurement -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/stack_monitor.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *
+ *  Measures the stack actually used by a program.  The free memory
+ *  below the stack is filled with a known pattern ("painted"), and the
+ *  deepest byte that no longer holds the pattern marks the high-water
+ *  point of the stack.
+ *
+ *  @code
+ *  __gnu_cxx::stack_monitor::paint();
+ *  std::sort(first, last);
+ *  std::size_t __peak = __gnu_cxx::stack_monitor::high_water();
+ *  @endcode
+ *
+ *  The functions without arguments work on the main stack and are
+ *  defined by src/stack.cc for AVR targets; building that file with
+ *  MODM_STACK_PAINT also paints the whole free memory at startup, before
+ *  any constructor runs.  The overloads taking a memory range work on any
+ *  stack, such as that of a task of a scheduler.
+ */
+
+#ifndef _STACK_MONITOR_H
+#define _STACK_MONITOR_H 1
+
+#pragma GCC system_header
+
+#include <cstddef>
+
+#if !defined(MODM_STACK_PATTERN)
+#define MODM_STACK_PATTERN 0xc5
+#endif
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Stack high-water instrumentation for stacks growing downwards.
+  struct stack_monitor
+  {
+    /// The byte value free stack memory is painted with.
+    static constexpr unsigned char pattern = MODM_STACK_PATTERN;
+
+    /// Paint the free memory between the heap and the stack pointer.
+    static void
+    paint() noexcept;
+
+    /// The most bytes of stack in use at any time since the last paint,
+    /// counted from the top of the stack.  Memory that the heap gave
+    /// back after the paint is not counted, memory that it took is.
+    static std::size_t
+    high_water() noexcept;
+
+    /// The bytes of stack in use now, counted from the top of the stack.
+    static std::size_t
+    depth() noexcept;
+
+    /// The bytes between the heap and the high-water point, which have
+    /// not been touched since the last paint.
+    static std::size_t
+    unused() noexcept;
+
+    /// Paint the memory [__first, __last) of a stack that is not in use.
+    static void
+    paint(void* __first, void* __last) noexcept
+    {
+      unsigned char* __end = static_cast<unsigned char*>(__last);
+      for (unsigned char* __p = static_cast<unsigned char*>(__first);
+	   __p < __end; ++__p)
+	*__p = pattern;
+    }
+
+    /// The high-water mark of the stack occupying [__first, __last),
+    /// which grows down from @a __last, in bytes.
+    static std::size_t
+    high_water(const void* __first, const void* __last) noexcept
+    {
+      const unsigned char* __p = static_cast<const unsigned char*>(__first);
+      const unsigned char* __end = static_cast<const unsigned char*>(__last);
+      while (__p < __end && *__p == pattern)
+	++__p;
+      return static_cast<std::size_t>(__end - __p);
+    }
+  };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // _STACK_MONITOR_H
@@ -0,0 +1,234 @@
+// Reference implementations of the <chrono> clocks -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+// This file defines std::chrono::high_resolution_clock::now() and
+// std::chrono::cycle_clock::now(), which <chrono> only declares.
+// Nothing is defined unless a clock source has been selected, so that
+// projects supplying their own now() can still compile every file in
+// src/.
+//
+// On AVR, define MODM_CHRONO_TIMER to the number of a hardware timer
+// (0 to 5).  The timer is started free-running by a constructor before
+// main(), and its overflow interrupt extends the counter in software.
+// MODM_CHRONO_PRESCALER (default 8) and F_CPU select the tick period and
+// hence the resolution of the clock.  The timer's overflow vector and
+// the interrupt enable flag are used; call sei() as usual.  The cycle
+// clock reads the same timer, so its resolution is MODM_CHRONO_PRESCALER
+// cycles; use a prescaler of 1 for cycle-accurate profiling.
+//
+// On a host, define MODM_CHRONO_MOCK for a manually driven clock that is
+// controlled through <ext/mock_clock.h>, or MODM_CHRONO_MONOTONIC for a
+// clock backed by clock_gettime(CLOCK_MONOTONIC).
+
+#include <chrono>
+
+#if defined(__AVR__) && defined(MODM_CHRONO_TIMER)
+
+#include <cstdint>
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#ifndef F_CPU
+#error "F_CPU must be defined!"
+#endif
+
+#if !defined(MODM_CHRONO_PRESCALER)
+#define MODM_CHRONO_PRESCALER 8
+#endif
+
+#define _MODM_CHRONO_CAT2(a, b, c) a ## b ## c
+#define _MODM_CHRONO_CAT(a, b, c) _MODM_CHRONO_CAT2(a, b, c)
+#define _MODM_CHRONO_REG(name) _MODM_CHRONO_CAT(name, MODM_CHRONO_TIMER, )
+#define _MODM_CHRONO_REG_B(name) _MODM_CHRONO_CAT(name, MODM_CHRONO_TIMER, B)
+
+#define _MODM_CHRONO_TCNT     _MODM_CHRONO_REG(TCNT)
+#define _MODM_CHRONO_TIFR     _MODM_CHRONO_REG(TIFR)
+#define _MODM_CHRONO_TOV      _MODM_CHRONO_REG(TOV)
+#define _MODM_CHRONO_TIMSK    _MODM_CHRONO_REG(TIMSK)
+#define _MODM_CHRONO_TOIE     _MODM_CHRONO_REG(TOIE)
+#define _MODM_CHRONO_TCCRA    _MODM_CHRONO_CAT(TCCR, MODM_CHRONO_TIMER, A)
+#define _MODM_CHRONO_TCCRB    _MODM_CHRONO_REG_B(TCCR)
+#define _MODM_CHRONO_OVF_vect _MODM_CHRONO_CAT(TIMER, MODM_CHRONO_TIMER, _OVF_vect)
+
+namespace
+{
+#if (MODM_CHRONO_TIMER == 0) || (MODM_CHRONO_TIMER == 2)
+  using __counter_type = std::uint8_t;
+#else
+  using __counter_type = std::uint16_t;
+#endif
+
+  // Clock select bits CSn2:0 for the configured prescaler.  Timer 2 is
+  // the asynchronous timer and has a finer set of prescalers.
+  constexpr std::uint8_t
+  __clock_select(unsigned long __prescaler)
+  {
+#if (MODM_CHRONO_TIMER == 2)
+    return __prescaler == 1UL    ? 1U
+	 : __prescaler == 8UL    ? 2U
+	 : __prescaler == 32UL   ? 3U
+	 : __prescaler == 64UL   ? 4U
+	 : __prescaler == 128UL  ? 5U
+	 : __prescaler == 256UL  ? 6U
+	 : __prescaler == 1024UL ? 7U : 0U;
+#else
+    return __prescaler == 1UL    ? 1U
+	 : __prescaler == 8UL    ? 2U
+	 : __prescaler == 64UL   ? 3U
+	 : __prescaler == 256UL  ? 4U
+	 : __prescaler == 1024UL ? 5U : 0U;
+#endif
+  }
+
+  static_assert(__clock_select(MODM_CHRONO_PRESCALER) != 0U,
+		"MODM_CHRONO_PRESCALER is not supported by this timer");
+
+  constexpr unsigned __counter_bits = 8U * sizeof(__counter_type);
+
+  // One timer tick, as a chrono period.
+  using __tick = std::chrono::duration<std::int64_t,
+				       std::ratio<MODM_CHRONO_PRESCALER, F_CPU>>;
+
+  // Number of timer overflows, extended in the overflow ISR.  It is as
+  // wide as the tick count, so that the tick count never wraps within
+  // the uptime of a device and the clock stays steady.
+  volatile std::uint64_t __overflows;
+
+  void __chrono_timer_init() __attribute__ ((constructor, used));
+
+  void
+  __chrono_timer_init()
+  {
+    // Normal mode, counting freely from 0 up to the counter's maximum.
+    _MODM_CHRONO_TCCRA = 0U;
+    _MODM_CHRONO_TIFR  = static_cast<std::uint8_t>(1U << _MODM_CHRONO_TOV);
+    _MODM_CHRONO_TIMSK = static_cast<std::uint8_t>(1U << _MODM_CHRONO_TOIE);
+    _MODM_CHRONO_TCCRB = __clock_select(MODM_CHRONO_PRESCALER);
+  }
+
+  // Read the overflow count and the live counter as one consistent tick
+  // without disabling interrupts.  The overflow count is read before and
+  // after the counter; if the overflow ISR ran in between (or tore the
+  // first multi-byte read), the two reads differ and the sample is taken
+  // again.  When now() runs with interrupts disabled, an overflow may be
+  // pending without having been counted yet; a set overflow flag
+  // together with a counter value in the lower half means the counter
+  // wrapped before it was read, so that overflow is added here.
+  std::uint64_t
+  __read_ticks()
+  {
+    std::uint64_t __ovf;
+    __counter_type __cnt;
+    bool __pending;
+
+    for (;;)
+      {
+	__ovf = __overflows;
+	__cnt = _MODM_CHRONO_TCNT;
+	__pending = (_MODM_CHRONO_TIFR & (1U << _MODM_CHRONO_TOV)) != 0U;
+	if (__ovf == __overflows)
+	  break;
+      }
+
+    if (__pending && (__cnt < (__counter_type(1U) << (__counter_bits - 1U))))
+      ++__ovf;
+
+    return (__ovf << __counter_bits) | __cnt;
+  }
+} // namespace
+
+ISR(_MODM_CHRONO_OVF_vect)
+{
+  __overflows = __overflows + 1U;
+}
+
+auto std::chrono::high_resolution_clock::now() noexcept -> time_point
+{
+  const __tick __t(static_cast<std::int64_t>(__read_ticks()));
+  return time_point(duration_cast<duration>(__t));
+}
+
+auto std::chrono::cycle_clock::now() noexcept -> time_point
+{
+  return time_point(duration(static_cast<rep>(__read_ticks()
+					       * MODM_CHRONO_PRESCALER)));
+}
+
+#elif defined(MODM_CHRONO_MOCK)
+
+#include <ext/mock_clock.h>
+
+namespace
+{
+  using __clock = std::chrono::high_resolution_clock;
+
+  __clock::duration __mock_now;
+  __clock::duration __mock_step;
+}
+
+void
+__gnu_cxx::mock_clock::set(const __clock::time_point& __t) noexcept
+{ __mock_now = __t.time_since_epoch(); }
+
+void
+__gnu_cxx::mock_clock::advance(const __clock::duration& __d) noexcept
+{ __mock_now += __d; }
+
+void
+__gnu_cxx::mock_clock::set_step(const __clock::duration& __d) noexcept
+{ __mock_step = __d; }
+
+auto std::chrono::high_resolution_clock::now() noexcept -> time_point
+{
+  const time_point __t(__mock_now);
+  __mock_now += __mock_step;
+  return __t;
+}
+
+auto std::chrono::cycle_clock::now() noexcept -> time_point
+{
+  return time_point(duration_cast<duration>(__mock_now));
+}
+
+#elif defined(MODM_CHRONO_MONOTONIC)
+
+#include <time.h>
+
+auto std::chrono::high_resolution_clock::now() noexcept -> time_point
+{
+  ::timespec __ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &__ts);
+  return time_point(duration_cast<duration>(seconds(__ts.tv_sec)
+					      + nanoseconds(__ts.tv_nsec)));
+}
+
+auto std::chrono::cycle_clock::now() noexcept -> time_point
+{
+  ::timespec __ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &__ts);
+  return time_point(duration_cast<duration>(seconds(__ts.tv_sec)
+					      + nanoseconds(__ts.tv_nsec)));
+}
+
+#endif
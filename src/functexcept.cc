@@ -11,77 +11,237 @@
 
 #include <bits/functexcept.h>
 
+// With MODM_FAULT_LOG defined, each __throw_* function records a
+// fault_record in __gnu_cxx::fault_log before aborting.  The messages
+// passed in are not text but the ids produced by __N, see <bits/c++config.h>.
+
+#if defined(MODM_FAULT_LOG)
+
+#include <ext/fault_log.h>
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+
+namespace
+{
+	using __gnu_cxx::fault_kind;
+	using __gnu_cxx::fault_record;
+	using __gnu_cxx::fault_log;
+
+	// Written when the ring is first used; any other value after a reset
+	// means the RAM was not retained, or the capacity has changed.
+	constexpr unsigned short __fault_magic = 0xfa00 | fault_log::capacity;
+
+	struct __fault_ring
+	{
+		unsigned short _M_magic;
+		unsigned char _M_next;
+		unsigned char _M_count;
+		fault_record _M_records[fault_log::capacity];
+	};
+
+	// .noinit is neither zeroed nor copied from flash by the startup code.
+#if defined(__AVR__)
+	__fault_ring __ring __attribute__((section(".noinit")));
+#else
+	__fault_ring __ring;
+#endif
+
+	// Restores SREG and with it the interrupt flag on scope exit.
+	struct __fault_lock
+	{
+#if defined(__AVR__)
+		unsigned char _M_sreg = SREG;
+
+		__fault_lock() noexcept
+		{ cli(); }
+
+		~__fault_lock()
+		{ SREG = _M_sreg; }
+#else
+		__fault_lock() noexcept
+		{ }
+#endif
+	};
+
+	void
+	__fault_validate() noexcept
+	{
+		if (__ring._M_magic != __fault_magic
+		    || __ring._M_next >= fault_log::capacity
+		    || __ring._M_count > fault_log::capacity)
+		{
+			__ring._M_magic = __fault_magic;
+			__ring._M_next = 0;
+			__ring._M_count = 0;
+		}
+	}
+
+	[[noreturn]] void
+	__fault_abort(fault_kind __kind, const char* __s, const void* __address)
+	{
+		const auto __message = static_cast<unsigned short>(
+			reinterpret_cast<__UINTPTR_TYPE__>(__s));
+		fault_log::record(__kind, __message, __address);
+		__builtin_abort();
+	}
+}
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+	std::size_t
+	fault_log::size() noexcept
+	{
+		__fault_lock __lock;
+		__fault_validate();
+		return __ring._M_count;
+	}
+
+	fault_record
+	fault_log::get(std::size_t __i) noexcept
+	{
+		__fault_lock __lock;
+		__fault_validate();
+		if (__i >= __ring._M_count)
+			return fault_record{};
+		std::size_t __slot = __ring._M_next + capacity - __ring._M_count + __i;
+		return __ring._M_records[__slot % capacity];
+	}
+
+	void
+	fault_log::clear() noexcept
+	{
+		__fault_lock __lock;
+		__ring._M_magic = __fault_magic;
+		__ring._M_next = 0;
+		__ring._M_count = 0;
+	}
+
+	void
+	fault_log::record(fault_kind __kind, unsigned short __message,
+			  const void* __address) noexcept
+	{
+		const auto __addr = reinterpret_cast<std::uintptr_t>(__address);
+		__fault_lock __lock;
+		__fault_validate();
+		if (__ring._M_count != 0)
+		{
+			fault_record& __last = __ring._M_records[
+				(__ring._M_next + capacity - 1) % capacity];
+			if (__last.kind == __kind && __last.message == __message
+			    && __last.address == __addr)
+			{
+				if (__last.repeat != 0xff)
+					++__last.repeat;
+				return;
+			}
+		}
+		__ring._M_records[__ring._M_next] = { __kind, 0, __message, __addr };
+		__ring._M_next = (__ring._M_next + 1) % capacity;
+		if (__ring._M_count != capacity)
+			++__ring._M_count;
+	}
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#define _MODM_FAULT(__kind, __s) \
+	__fault_abort(fault_kind::__kind, __s, __builtin_return_address(0))
+#else
+#define _MODM_FAULT(__kind, __s) __builtin_abort()
+#endif
+
 namespace std _GLIBCXX_VISIBILITY(default)
 {
 _GLIBCXX_BEGIN_NAMESPACE_VERSION
 
 	void __attribute__((weak))
 	__throw_bad_exception()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_exception, nullptr); }
 
 	void __attribute__((weak))
 	__throw_bad_alloc()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_alloc, nullptr); }
 
 	void __attribute__((weak))
 	__throw_bad_cast()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_cast, nullptr); }
 
 	void __attribute__((weak))
 	__throw_bad_typeid()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_typeid, nullptr); }
 
 	void __attribute__((weak))
 	__throw_logic_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(logic_error, __s); }
 
 	void __attribute__((weak))
 	__throw_domain_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(domain_error, __s); }
 
 	void __attribute__((weak))
 	__throw_invalid_argument(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(invalid_argument, __s); }
 
 	void __attribute__((weak))
 	__throw_length_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(length_error, __s); }
 
 	void __attribute__((weak))
 	__throw_out_of_range(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(out_of_range, __s); }
 
 	void __attribute__((weak))
 	__throw_runtime_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(runtime_error, __s); }
 
 	void __attribute__((weak))
 	__throw_range_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(range_error, __s); }
 
 	void __attribute__((weak))
 	__throw_overflow_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(overflow_error, __s); }
 
 	void __attribute__((weak))
 	__throw_underflow_error(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(underflow_error, __s); }
 
 	void __attribute__((weak))
 	__throw_bad_optional_access()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_optional_access, nullptr); }
 
 	void __attribute__((weak))
 	__throw_bad_variant_access(const char* __s __attribute__((unused)))
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_variant_access, __s); }
+
+	// The message is the error code.
+	void __attribute__((weak))
+	__throw_system_error(int __e __attribute__((unused)))
+	{
+		_MODM_FAULT(system_error, reinterpret_cast<const char*>(
+			static_cast<__UINTPTR_TYPE__>(static_cast<unsigned short>(__e))));
+	}
 
 	void __attribute__((weak))
 	__throw_bad_function_call()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_function_call, nullptr); }
 
 	void __attribute__((weak))
 	__throw_bad_any_cast()
-	{ __builtin_abort(); }
+	{ _MODM_FAULT(bad_any_cast, nullptr); }
+
+	void __attribute__((weak))
+	__throw_bad_expected_access()
+	{ _MODM_FAULT(bad_expected_access, nullptr); }
+
+	void __attribute__((weak))
+	__throw_bad_weak_ptr()
+	{ _MODM_FAULT(bad_weak_ptr, nullptr); }
 
 _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace
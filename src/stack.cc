@@ -0,0 +1,160 @@
+// Stack painting and high-water measurement -*- C++ -*-
+
+// Copyright (C) 2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+// This file defines the main stack functions of __gnu_cxx::stack_monitor
+// for AVR targets.  The stack grows down from the linker symbol __stack
+// (normally RAMEND) towards the end of the heap, which is __brkval once
+// malloc() has been used and __heap_start before.
+//
+// Define MODM_STACK_PAINT to paint all memory from __heap_start to
+// __stack in .init3, that is before .data and .bss are initialized and
+// before any constructor runs, so that high_water() covers the whole
+// program including static initialization.
+
+#include <ext/stack_monitor.h>
+
+#if defined(__AVR__)
+
+#include <avr/io.h>
+
+extern "C"
+{
+  extern char __heap_start;
+  extern char __stack;
+  extern char* __brkval;
+}
+
+namespace
+{
+  unsigned char*
+  __heap_end() noexcept
+  {
+    return reinterpret_cast<unsigned char*>(__brkval != nullptr
+					    ? __brkval : &__heap_start);
+  }
+
+  // One past the topmost byte of the stack.
+  unsigned char*
+  __stack_end() noexcept
+  { return reinterpret_cast<unsigned char*>(&__stack) + 1; }
+
+  // The stack pointer addresses the next free byte.
+  unsigned char*
+  __stack_pointer() noexcept
+  { return reinterpret_cast<unsigned char*>(SP); }
+
+  // The lowest byte painted by paint(), or null if only the startup
+  // code (if any) has painted, which starts at __heap_start.
+  unsigned char* __paint_first;
+
+  // Where the scan for the high-water point starts.  free() lowers
+  // __brkval when it releases the topmost chunk, and the memory given
+  // back was never painted, so the scan must not start below the lowest
+  // painted byte; nor below the current end of the heap, which may
+  // have grown since.
+  unsigned char*
+  __scan_first() noexcept
+  {
+    unsigned char* __first = __paint_first != nullptr
+      ? __paint_first : reinterpret_cast<unsigned char*>(&__heap_start);
+    unsigned char* __heap = __heap_end();
+    return __heap > __first ? __heap : __first;
+  }
+}
+
+#if defined(MODM_STACK_PAINT)
+
+#define _MODM_STACK_STR2(x) #x
+#define _MODM_STACK_STR(x) _MODM_STACK_STR2(x)
+
+namespace
+{
+  // Runs inline as part of the startup code; nothing is on the stack yet
+  // and r1 is already zero.
+  void __stack_paint_init() __attribute__ ((naked, used, section(".init3")));
+
+  void
+  __stack_paint_init()
+  {
+    asm volatile (
+      "ldi r30, lo8(__heap_start)\n\t"
+      "ldi r31, hi8(__heap_start)\n\t"
+      "ldi r24, " _MODM_STACK_STR(MODM_STACK_PATTERN) "\n\t"
+      "ldi r25, hi8(__stack)\n\t"
+      "rjmp 2f\n"
+      "1:\n\t"
+      "st Z+, r24\n"
+      "2:\n\t"
+      "cpi r30, lo8(__stack)\n\t"
+      "cpc r31, r25\n\t"
+      "brlo 1b\n\t"
+      "breq 1b");
+  }
+}
+
+#endif // MODM_STACK_PAINT
+
+void
+__gnu_cxx::stack_monitor::paint() noexcept
+{
+  // Everything below the stack pointer is free, including the byte it
+  // points at.  The loop keeps its state in registers and reads SP only
+  // once it runs: a call to paint(void*, void*), or a loop whose
+  // variables live in the frame as at -O0, would overwrite its own
+  // return address and locals at and below the stack pointer.
+  unsigned char* __p = __heap_end();
+  unsigned char* __sp;
+  __paint_first = __p;
+  asm volatile (
+    "in %A1, __SP_L__\n\t"
+    "in %B1, __SP_H__\n\t"
+    "rjmp 2f\n"
+    "1:\n\t"
+    "st Z+, %2\n"
+    "2:\n\t"
+    "cp %A0, %A1\n\t"
+    "cpc %B0, %B1\n\t"
+    "brlo 1b\n\t"
+    "breq 1b"
+    : "+z" (__p), "=&r" (__sp)
+    : "r" (pattern)
+    : "memory");
+}
+
+std::size_t
+__gnu_cxx::stack_monitor::high_water() noexcept
+{ return high_water(__scan_first(), __stack_end()); }
+
+std::size_t
+__gnu_cxx::stack_monitor::depth() noexcept
+{ return static_cast<std::size_t>(__stack_end() - __stack_pointer() - 1); }
+
+std::size_t
+__gnu_cxx::stack_monitor::unused() noexcept
+{
+  return static_cast<std::size_t>(__stack_end() - __scan_first())
+	 - high_water();
+}
+
+#endif // __AVR__